@@ -0,0 +1,263 @@
+#include "AlgebraicMultigrid.h"
+
+#include <cmath>
+#include <limits>
+
+// Levels at or below this size are solved directly
+#define AMG_COARSEST_SIZE 256
+#define AMG_MAX_LEVELS 24
+// a_ij is a strong connection if |a_ij| >= threshold * sqrt(|a_ii * a_jj|)
+#define AMG_STRENGTH_THRESHOLD 0.08
+// Stop coarsening once a level no longer shrinks by this factor
+#define AMG_MIN_COARSENING 0.8
+
+namespace {
+    constexpr unsigned int NO_AGGREGATE = std::numeric_limits<unsigned int>::max();
+
+    bool inverseDiagonalOf(const SparseMatrix& matrix, std::vector<double>& inverseDiagonal) {
+        inverseDiagonal.resize(matrix.size);
+
+        for (unsigned int row = 0; row < matrix.size; row++) {
+            const double diagonal = matrix.at(row, row);
+            if (diagonal == 0.0) {
+                return false;
+            }
+            inverseDiagonal[row] = 1.0 / diagonal;
+        }
+
+        return true;
+    }
+}
+
+AlgebraicMultigrid::AlgebraicMultigrid(const double tolerance, const unsigned int maxIterations)
+    : tolerance(tolerance),
+      maxIterations(maxIterations) {
+}
+
+bool AlgebraicMultigrid::setup(const SparseMatrix& matrix) {
+    levels.clear();
+    levels.push_back({matrix, {}, {}, {}});
+
+    while (levels.size() < AMG_MAX_LEVELS) {
+        Level& fine = levels.back();
+        if (!inverseDiagonalOf(fine.matrix, fine.inverseDiagonal)) {
+            return false;
+        }
+
+        if (fine.matrix.size <= AMG_COARSEST_SIZE) {
+            break;
+        }
+
+        const SparseMatrix tentative = aggregate(fine.matrix);
+        if (tentative.columnCount > AMG_MIN_COARSENING * fine.matrix.size) {
+            break;
+        }
+
+        fine.prolongation = smoothProlongation(fine.matrix, fine.inverseDiagonal, tentative);
+        fine.restriction = fine.prolongation.transpose();
+
+        // Galerkin coarse operator R A P
+        SparseMatrix coarse = fine.restriction.multiply(fine.matrix.multiply(fine.prolongation));
+        levels.push_back({std::move(coarse), {}, {}, {}});
+    }
+
+    return coarseSolver.setup(levels.back().matrix);
+}
+
+LinearSolveReport AlgebraicMultigrid::solve(const std::vector<double>& rhs, std::vector<double>& x) const {
+    const SparseMatrix& matrix = levels.front().matrix;
+    LinearSolveReport report;
+
+    x.resize(matrix.size, 0.0);
+    report.relativeResidual = relativeResidual(matrix, rhs, x);
+    while (report.relativeResidual >= tolerance && report.iterations < maxIterations) {
+        vCycle(0, rhs, x);
+
+        report.iterations++;
+        report.relativeResidual = relativeResidual(matrix, rhs, x);
+
+        if (checkpoint && checkpoint(report.iterations, report.relativeResidual)) {
+            break;
+        }
+    }
+
+    report.converged = report.relativeResidual < tolerance;
+    return report;
+}
+
+void AlgebraicMultigrid::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    z.assign(r.size(), 0.0);
+    vCycle(0, r, z);
+}
+
+unsigned int AlgebraicMultigrid::levelCount() const {
+    return levels.size();
+}
+
+void AlgebraicMultigrid::vCycle(const unsigned int level, const std::vector<double>& rhs, std::vector<double>& x) const {
+    if (level + 1 == levels.size()) {
+        coarseSolver.solve(rhs, x);
+        return;
+    }
+
+    const Level& fine = levels[level];
+    const SparseMatrix& matrix = fine.matrix;
+
+    const auto relax = [&](const unsigned int row) {
+        double sum = rhs[row];
+        for (unsigned int entry = matrix.rowOffsets[row]; entry < matrix.rowOffsets[row + 1]; entry++) {
+            if (matrix.columns[entry] != row) {
+                sum -= matrix.values[entry] * x[matrix.columns[entry]];
+            }
+        }
+        x[row] = sum * fine.inverseDiagonal[row];
+    };
+
+    // Pre-smoothing: forward Gauss-Seidel
+    for (unsigned int row = 0; row < matrix.size; row++) {
+        relax(row);
+    }
+
+    // Coarse grid correction
+    std::vector<double> residual;
+    matrix.residual(rhs, x, residual);
+
+    std::vector<double> coarseRhs;
+    fine.restriction.multiply(residual, coarseRhs);
+
+    std::vector<double> coarseCorrection(coarseRhs.size(), 0.0);
+    vCycle(level + 1, coarseRhs, coarseCorrection);
+
+    std::vector<double> correction;
+    fine.prolongation.multiply(coarseCorrection, correction);
+    for (unsigned int row = 0; row < matrix.size; row++) {
+        x[row] += correction[row];
+    }
+
+    // Post-smoothing: backward Gauss-Seidel
+    for (unsigned int row = matrix.size; row-- > 0;) {
+        relax(row);
+    }
+}
+
+SparseMatrix AlgebraicMultigrid::aggregate(const SparseMatrix& matrix) {
+    const unsigned int n = matrix.size;
+
+    std::vector<double> diagonal(n);
+    for (unsigned int row = 0; row < n; row++) {
+        diagonal[row] = std::abs(matrix.at(row, row));
+    }
+
+    const auto isStrong = [&](const unsigned int row, const unsigned int entry) {
+        const unsigned int column = matrix.columns[entry];
+        return column != row &&
+               std::abs(matrix.values[entry]) >= AMG_STRENGTH_THRESHOLD * std::sqrt(diagonal[row] * diagonal[column]);
+    };
+
+    std::vector<unsigned int> aggregateOf(n, NO_AGGREGATE);
+    unsigned int aggregates = 0;
+
+    // Phase 1: vertices whose strong neighbourhood is still free seed a new aggregate with it
+    for (unsigned int row = 0; row < n; row++) {
+        bool free = aggregateOf[row] == NO_AGGREGATE;
+        bool connected = false;
+        for (unsigned int entry = matrix.rowOffsets[row]; entry < matrix.rowOffsets[row + 1] && free; entry++) {
+            if (isStrong(row, entry)) {
+                connected = true;
+                free = aggregateOf[matrix.columns[entry]] == NO_AGGREGATE;
+            }
+        }
+
+        if (!free || !connected) {
+            continue;
+        }
+
+        aggregateOf[row] = aggregates;
+        for (unsigned int entry = matrix.rowOffsets[row]; entry < matrix.rowOffsets[row + 1]; entry++) {
+            if (isStrong(row, entry)) {
+                aggregateOf[matrix.columns[entry]] = aggregates;
+            }
+        }
+        aggregates++;
+    }
+
+    // Phase 2: leftovers join the aggregate of their strongest phase 1 neighbour
+    const std::vector<unsigned int> seeded = aggregateOf;
+    for (unsigned int row = 0; row < n; row++) {
+        if (seeded[row] != NO_AGGREGATE) {
+            continue;
+        }
+
+        double strongest = 0.0;
+        for (unsigned int entry = matrix.rowOffsets[row]; entry < matrix.rowOffsets[row + 1]; entry++) {
+            if (isStrong(row, entry) &&
+                seeded[matrix.columns[entry]] != NO_AGGREGATE &&
+                std::abs(matrix.values[entry]) > strongest) {
+                strongest = std::abs(matrix.values[entry]);
+                aggregateOf[row] = seeded[matrix.columns[entry]];
+            }
+        }
+    }
+
+    // Phase 3: whatever is left (including isolated vertices) forms aggregates with its free neighbours
+    for (unsigned int row = 0; row < n; row++) {
+        if (aggregateOf[row] != NO_AGGREGATE) {
+            continue;
+        }
+
+        aggregateOf[row] = aggregates;
+        for (unsigned int entry = matrix.rowOffsets[row]; entry < matrix.rowOffsets[row + 1]; entry++) {
+            if (isStrong(row, entry) && aggregateOf[matrix.columns[entry]] == NO_AGGREGATE) {
+                aggregateOf[matrix.columns[entry]] = aggregates;
+            }
+        }
+        aggregates++;
+    }
+
+    // Piecewise constant interpolation, constants are the near null space of Floater's system
+    std::vector<unsigned int> rows(n);
+    std::vector<double> values(n, 1.0);
+    for (unsigned int row = 0; row < n; row++) {
+        rows[row] = row;
+    }
+
+    return SparseMatrix(n, aggregates, rows, aggregateOf, values);
+}
+
+SparseMatrix AlgebraicMultigrid::smoothProlongation(
+    const SparseMatrix& matrix,
+    const std::vector<double>& inverseDiagonal,
+    const SparseMatrix& tentative
+) {
+    // Gershgorin bound on the spectral radius of D^-1 A
+    double spectralRadius = 0.0;
+    for (unsigned int row = 0; row < matrix.size; row++) {
+        double rowSum = 0.0;
+        for (unsigned int entry = matrix.rowOffsets[row]; entry < matrix.rowOffsets[row + 1]; entry++) {
+            rowSum += std::abs(matrix.values[entry]);
+        }
+        spectralRadius = std::max(spectralRadius, rowSum * std::abs(inverseDiagonal[row]));
+    }
+    const double omega = 4.0 / (3.0 * spectralRadius);
+
+    const SparseMatrix smoothed = matrix.multiply(tentative);
+
+    std::vector<unsigned int> rows;
+    std::vector<unsigned int> columns;
+    std::vector<double> values;
+    for (const SparseMatrix* source : {&tentative, &smoothed}) {
+        const bool isCorrection = source == &smoothed;
+
+        for (unsigned int row = 0; row < source->size; row++) {
+            const double scale = isCorrection ? -omega * inverseDiagonal[row] : 1.0;
+
+            for (unsigned int entry = source->rowOffsets[row]; entry < source->rowOffsets[row + 1]; entry++) {
+                rows.push_back(row);
+                columns.push_back(source->columns[entry]);
+                values.push_back(scale * source->values[entry]);
+            }
+        }
+    }
+
+    return SparseMatrix(tentative.size, tentative.columnCount, rows, columns, values);
+}
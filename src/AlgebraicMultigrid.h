@@ -0,0 +1,60 @@
+#ifndef ALGEBRAIC_MULTIGRID_H
+#define ALGEBRAIC_MULTIGRID_H
+
+#include <vector>
+
+#include "LinearSolver.h"
+#include "Preconditioner.h"
+#include "SparseLUSolver.h"
+
+// Smoothed aggregation algebraic multigrid
+// Usable standalone (repeated V-cycles) or as a preconditioner (a single V-cycle from zero)
+// Smoothing is forward Gauss-Seidel going down and backward Gauss-Seidel coming up,
+// which keeps the V-cycle symmetric for symmetric matrices and so valid inside CG
+class AlgebraicMultigrid : public LinearSolver, public Preconditioner {
+    // One grid of the hierarchy, level 0 is the input matrix
+    struct Level {
+        SparseMatrix matrix;
+        // Prolongation from the next coarser level, and its transpose (restriction)
+        SparseMatrix prolongation;
+        SparseMatrix restriction;
+        std::vector<double> inverseDiagonal;
+    };
+
+    std::vector<Level> levels;
+    // The coarsest level is solved exactly
+    SparseLUSolver coarseSolver;
+
+    // Standalone stopping criteria, ||r|| / ||rhs||
+    double tolerance;
+    unsigned int maxIterations;
+
+public:
+    AlgebraicMultigrid(double tolerance, unsigned int maxIterations);
+
+    bool setup(const SparseMatrix& matrix) override;
+
+    // Standalone solve: V-cycles until the relative residual falls below tolerance
+    LinearSolveReport solve(const std::vector<double>& rhs, std::vector<double>& x) const override;
+
+    // Preconditioner: z = one V-cycle applied to r starting from z = 0
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override;
+
+    unsigned int levelCount() const;
+
+private:
+    // Improves x towards levels[level].matrix * x = rhs
+    void vCycle(unsigned int level, const std::vector<double>& rhs, std::vector<double>& x) const;
+
+    // Tentative prolongation by greedy aggregation of strongly connected vertices
+    static SparseMatrix aggregate(const SparseMatrix& matrix);
+
+    // Damped Jacobi smoothing of the tentative prolongation: P = (I - omega D^-1 A) P0
+    static SparseMatrix smoothProlongation(
+        const SparseMatrix& matrix,
+        const std::vector<double>& inverseDiagonal,
+        const SparseMatrix& tentative
+    );
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+SkylinePacker::SkylinePacker(const float width)
+    : width(width),
+      skyline{Segment(0.0f, 0.0f, width)},
+      top(0.0f) {
+}
+
+Cartesian3 SkylinePacker::place(const float w, const float h) {
+    // Round-off in the segment ends must not push a rectangle that fits exactly out of the strip
+    const float limit = width * (1.0f + 1e-5f);
+
+    unsigned int bestSegment = 0;
+    float bestY = std::numeric_limits<float>::infinity();
+    for (unsigned int i = 0; i < skyline.size(); i++) {
+        const float x = skyline[i].x;
+        if (i > 0 && x + w > limit) {
+            break;
+        }
+
+        // Rests on the highest segment under [x, x + w)
+        float y = skyline[i].y;
+        for (unsigned int j = i + 1; j < skyline.size() && skyline[j].x < x + w; j++) {
+            y = std::max(y, skyline[j].y);
+        }
+
+        if (y < bestY) {
+            bestSegment = i;
+            bestY = y;
+        }
+    }
+
+    const float left = skyline[bestSegment].x;
+    const float right = left + w;
+
+    // Drop the segments now under the rectangle, and trim the one sticking out on its right
+    unsigned int end = bestSegment;
+    while (end < skyline.size() && skyline[end].x + skyline[end].width <= right) {
+        end++;
+    }
+    if (end < skyline.size() && skyline[end].x < right) {
+        skyline[end].width -= right - skyline[end].x;
+        skyline[end].x = right;
+    }
+    skyline.erase(skyline.begin() + bestSegment, skyline.begin() + end);
+    skyline.insert(skyline.begin() + bestSegment, Segment(left, bestY + h, w));
+
+    // Merge with neighbours of the same height, rows of equal squares stay a single segment
+    if (bestSegment + 1 < skyline.size() && skyline[bestSegment + 1].y == skyline[bestSegment].y) {
+        skyline[bestSegment].width += skyline[bestSegment + 1].width;
+        skyline.erase(skyline.begin() + bestSegment + 1);
+    }
+    if (bestSegment > 0 && skyline[bestSegment - 1].y == skyline[bestSegment].y) {
+        skyline[bestSegment - 1].width += skyline[bestSegment].width;
+        skyline.erase(skyline.begin() + bestSegment);
+    }
+
+    top = std::max(top, bestY + h);
+    return Cartesian3(left, bestY, 0.0f);
+}
+
+float SkylinePacker::height() const {
+    return top;
+}
+
+float packSquares(const std::vector<float>& sides, std::vector<Cartesian3>& corners) {
+    corners.assign(sides.size(), Cartesian3(0.0f, 0.0f, 0.0f));
+    if (sides.empty()) {
+        return 1.0f;
+    }
+
+    // Largest first keeps the skyline flat
+    std::vector<unsigned int> order(sides.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](const unsigned int a, const unsigned int b) {
+        return sides[a] > sides[b];
+    });
+
+    float area = 0.0f;
+    for (const float side : sides) {
+        area += side * side;
+    }
+    const float padding = ATLAS_PADDING * std::sqrt(area);
+    const float largest = sides[order.front()] + padding;
+    area = 0.0f;
+    for (const float side : sides) {
+        area += (side + padding) * (side + padding);
+    }
+
+    // The strip width giving a square atlas is not known up front, a few widths from the ideal one up are tried
+    float bestExtent = std::numeric_limits<float>::infinity();
+    std::vector<Cartesian3> placed(sides.size());
+    for (unsigned int trial = 0; trial < ATLAS_WIDTH_TRIALS; trial++) {
+        const float width = std::max(largest, std::sqrt(area) * (1.0f + 0.04f * trial));
+
+        SkylinePacker packer(width);
+        for (const unsigned int square : order) {
+            placed[square] = packer.place(sides[square] + padding, sides[square] + padding);
+        }
+
+        const float extent = std::max(width, packer.height());
+        if (extent < bestExtent) {
+            bestExtent = extent;
+            corners.swap(placed);
+            placed.resize(sides.size());
+        }
+    }
+
+    // Squares sit in the middle of their padded slot
+    const float scale = 1.0f / bestExtent;
+    for (Cartesian3& corner : corners) {
+        corner = (corner + Cartesian3(0.5f * padding, 0.5f * padding, 0.0f)) * scale;
+    }
+
+    return scale;
+}
@@ -0,0 +1,50 @@
+#ifndef ATLAS_PACKER_H
+#define ATLAS_PACKER_H
+
+#include <vector>
+
+#include "Cartesian3.h"
+
+// Gap left around every chart, as a fraction of the side of the packed atlas
+#define ATLAS_PADDING 0.001f
+// Strip widths tried when looking for the squarest atlas, each 4% wider than the last
+#define ATLAS_WIDTH_TRIALS 8
+
+// Bottom-left skyline packing of rectangles into a strip of fixed width and unbounded height
+// The skyline is the upper outline of everything placed so far, rectangles rest on it and never go under it
+// Placing one costs O(skyline segments), which stay few when rectangles come largest first
+class SkylinePacker {
+    // Run of the skyline from x to x + width, at height y
+    class Segment {
+    public:
+        float x;
+        float y;
+        float width;
+
+        Segment(const float x, const float y, const float width)
+            : x(x),
+              y(y),
+              width(width) {
+        }
+    };
+
+    const float width;
+    // Left to right, covering [0, width) without gaps
+    std::vector<Segment> skyline;
+    float top;
+
+public:
+    explicit SkylinePacker(float width);
+
+    // Places a w x h rectangle as low as it goes, then as far left, and returns its bottom-left corner
+    Cartesian3 place(float w, float h);
+
+    // Top of the highest rectangle placed
+    float height() const;
+};
+
+// Packs squares with the given sides into the unit square, keeping their relative sizes
+// Writes the bottom-left corner of every square to corners and returns the scale all sides were multiplied by
+float packSquares(const std::vector<float>& sides, std::vector<Cartesian3>& corners);
+
+#endif
@@ -0,0 +1,111 @@
+#include "BiCgStabSolver.h"
+
+#include <cmath>
+
+namespace {
+    double dot(const std::vector<double>& a, const std::vector<double>& b) {
+        double sum = 0.0;
+        for (unsigned int i = 0; i < a.size(); i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+}
+
+BiCgStabSolver::BiCgStabSolver(
+    std::unique_ptr<Preconditioner> preconditioner,
+    const double tolerance,
+    const unsigned int maxIterations
+) : preconditioner(std::move(preconditioner)),
+    tolerance(tolerance),
+    maxIterations(maxIterations) {
+}
+
+bool BiCgStabSolver::setup(const SparseMatrix& matrix) {
+    this->matrix = matrix;
+    return preconditioner->setup(matrix);
+}
+
+LinearSolveReport BiCgStabSolver::solve(const std::vector<double>& rhs, std::vector<double>& x) const {
+    const unsigned int n = matrix.size;
+    LinearSolveReport report;
+
+    std::vector<double> r;
+    std::vector<double> p(n, 0.0);
+    std::vector<double> q(n, 0.0);
+    std::vector<double> s(n);
+    std::vector<double> t;
+    // Preconditioned search directions M^-1 p and M^-1 s
+    std::vector<double> pHat;
+    std::vector<double> sHat;
+
+    x.resize(n, 0.0);
+    matrix.residual(rhs, x, r);
+    // Shadow residual, fixed for the whole solve
+    const std::vector<double> shadow = r;
+
+    const double rhsNorm = std::sqrt(dot(rhs, rhs));
+    const double scale = rhsNorm > 0.0 ? rhsNorm : 1.0;
+
+    double rho = 1.0;
+    double alpha = 1.0;
+    double omega = 1.0;
+
+    report.relativeResidual = std::sqrt(dot(r, r)) / scale;
+    while (report.relativeResidual >= tolerance && report.iterations < maxIterations) {
+        const double rhoNext = dot(shadow, r);
+        if (rhoNext == 0.0 || omega == 0.0) {
+            // Breakdown: r is orthogonal to the shadow residual, or the last step stagnated
+            break;
+        }
+
+        const double beta = (rhoNext / rho) * (alpha / omega);
+        rho = rhoNext;
+        for (unsigned int i = 0; i < n; i++) {
+            p[i] = r[i] + beta * (p[i] - omega * q[i]);
+        }
+
+        preconditioner->apply(p, pHat);
+        matrix.multiply(pHat, q);
+        const double shadowQ = dot(shadow, q);
+        if (shadowQ == 0.0) {
+            break;
+        }
+        alpha = rho / shadowQ;
+
+        for (unsigned int i = 0; i < n; i++) {
+            s[i] = r[i] - alpha * q[i];
+        }
+
+        // Half a step is sometimes enough
+        if (std::sqrt(dot(s, s)) / scale < tolerance) {
+            for (unsigned int i = 0; i < n; i++) {
+                x[i] += alpha * pHat[i];
+            }
+            r = s;
+            report.iterations++;
+            report.relativeResidual = std::sqrt(dot(r, r)) / scale;
+            break;
+        }
+
+        preconditioner->apply(s, sHat);
+        matrix.multiply(sHat, t);
+        const double tt = dot(t, t);
+        omega = tt > 0.0 ? dot(t, s) / tt : 0.0;
+
+        for (unsigned int i = 0; i < n; i++) {
+            x[i] += alpha * pHat[i] + omega * sHat[i];
+            r[i] = s[i] - omega * t[i];
+        }
+
+        report.iterations++;
+        report.relativeResidual = std::sqrt(dot(r, r)) / scale;
+
+        if (checkpoint && checkpoint(report.iterations, report.relativeResidual)) {
+            break;
+        }
+    }
+
+    report.converged = report.relativeResidual < tolerance;
+    return report;
+}
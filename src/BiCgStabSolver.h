@@ -0,0 +1,28 @@
+#ifndef BI_CG_STAB_SOLVER_H
+#define BI_CG_STAB_SOLVER_H
+
+#include <memory>
+
+#include "LinearSolver.h"
+#include "Preconditioner.h"
+
+// Right-preconditioned BiCGSTAB (van der Vorst) for general, possibly non-symmetric, matrices
+// Two matrix products and two preconditioner applications per iteration, seven work vectors
+class BiCgStabSolver : public LinearSolver {
+    SparseMatrix matrix;
+    std::unique_ptr<Preconditioner> preconditioner;
+
+    // Stop once ||r|| / ||rhs|| falls below this
+    double tolerance;
+    unsigned int maxIterations;
+
+public:
+    BiCgStabSolver(std::unique_ptr<Preconditioner> preconditioner, double tolerance, unsigned int maxIterations);
+
+    // Fails if the preconditioner cannot be built
+    bool setup(const SparseMatrix& matrix) override;
+
+    LinearSolveReport solve(const std::vector<double>& rhs, std::vector<double>& x) const override;
+};
+
+#endif
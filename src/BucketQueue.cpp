@@ -0,0 +1,64 @@
+#include "BucketQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+BucketQueue::BucketQueue()
+    : buckets(QUEUE_BUCKETS),
+      heads(QUEUE_BUCKETS, 0),
+      top(0),
+      count(0) {
+}
+
+unsigned int BucketQueue::popLocked(unsigned int* vertices, const unsigned int maxCount) {
+    while (heads[top] == buckets[top].size()) {
+        // Drained buckets are reset so they do not keep growing
+        buckets[top].clear();
+        heads[top] = 0;
+
+        if (top == 0) {
+            return 0;
+        }
+        top--;
+    }
+
+    const unsigned int popped = std::min<unsigned int>(maxCount, buckets[top].size() - heads[top]);
+    std::copy_n(buckets[top].begin() + heads[top], popped, vertices);
+    heads[top] += popped;
+    count.fetch_sub(popped, std::memory_order_relaxed);
+
+    return popped;
+}
+
+void BucketQueue::push(const unsigned int* vertices, const float* keys, const unsigned int pushCount) {
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    for (unsigned int i = 0; i < pushCount; i++) {
+        // ilogb is the binary exponent, so bucket k spans [2^k, 2^(k + 1))
+        const int exponent = keys[i] >= 1.0f && std::isfinite(keys[i]) ? std::ilogb(keys[i]) : 0;
+        const unsigned int bucket = std::isinf(keys[i]) ? QUEUE_BUCKETS - 1 : std::min(exponent, QUEUE_BUCKETS - 1);
+
+        buckets[bucket].push_back(vertices[i]);
+        top = std::max(top, bucket);
+    }
+
+    count.fetch_add(pushCount, std::memory_order_relaxed);
+}
+
+unsigned int BucketQueue::pop(unsigned int* vertices, const unsigned int maxCount) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    return popLocked(vertices, maxCount);
+}
+
+unsigned int BucketQueue::trySteal(unsigned int* vertices, const unsigned int maxCount) {
+    if (empty()) {
+        return 0;
+    }
+
+    const std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    return lock.owns_lock() ? popLocked(vertices, maxCount) : 0;
+}
+
+bool BucketQueue::empty() const {
+    return count.load(std::memory_order_relaxed) == 0;
+}
@@ -0,0 +1,41 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Number of priority buckets, bucket k holds keys in [2^k, 2^(k + 1)) and the last one everything above
+#define QUEUE_BUCKETS 32
+
+// Approximate priority queue of vertex ids, bucketed by the magnitude of their key
+// Entries of a bucket come out first in, first out. Entries move in batches to keep the locking cheap,
+// and the mutex lets other threads push into the queue and steal from it
+class BucketQueue {
+    std::mutex mutex;
+    std::vector<std::vector<unsigned int>> buckets;
+    // Entries of buckets[k] before heads[k] were popped already
+    std::vector<unsigned int> heads;
+    // No bucket above this one holds entries
+    unsigned int top;
+    // Total entries, readable without the lock
+    std::atomic<unsigned int> count;
+
+    unsigned int popLocked(unsigned int* vertices, unsigned int maxCount);
+
+public:
+    BucketQueue();
+
+    // Queues vertices[i] with priority keys[i], taken relative to 1: keys below it share the lowest bucket
+    void push(const unsigned int* vertices, const float* keys, unsigned int pushCount);
+
+    // Moves up to maxCount vertices from the highest non-empty bucket into vertices, returns how many
+    unsigned int pop(unsigned int* vertices, unsigned int maxCount);
+
+    // As pop, but returns 0 straight away if another thread holds the queue
+    unsigned int trySteal(unsigned int* vertices, unsigned int maxCount);
+
+    bool empty() const;
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "ConjugateGradientSolver.h"
+
+#include <cmath>
+
+namespace {
+    double dot(const std::vector<double>& a, const std::vector<double>& b) {
+        double sum = 0.0;
+        for (unsigned int i = 0; i < a.size(); i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    bool isSymmetric(const SparseMatrix& matrix) {
+        const SparseMatrix transposed = matrix.transpose();
+        return transposed.columns == matrix.columns && transposed.values == matrix.values;
+    }
+}
+
+ConjugateGradientSolver::ConjugateGradientSolver(
+    std::unique_ptr<Preconditioner> preconditioner,
+    const double tolerance,
+    const unsigned int maxIterations
+) : preconditioner(std::move(preconditioner)),
+    tolerance(tolerance),
+    maxIterations(maxIterations) {
+}
+
+bool ConjugateGradientSolver::setup(const SparseMatrix& matrix) {
+    this->matrix = matrix;
+    return isSymmetric(matrix) && preconditioner->setup(matrix);
+}
+
+LinearSolveReport ConjugateGradientSolver::solve(const std::vector<double>& rhs, std::vector<double>& x) const {
+    const unsigned int n = matrix.size;
+    LinearSolveReport report;
+
+    std::vector<double> r;
+    std::vector<double> z;
+    std::vector<double> p;
+    std::vector<double> q;
+
+    x.resize(n, 0.0);
+    matrix.residual(rhs, x, r);
+
+    const double rhsNorm = std::sqrt(dot(rhs, rhs));
+    const double scale = rhsNorm > 0.0 ? rhsNorm : 1.0;
+
+    preconditioner->apply(r, z);
+    p = z;
+    double rz = dot(r, z);
+
+    report.relativeResidual = std::sqrt(dot(r, r)) / scale;
+    while (report.relativeResidual >= tolerance && report.iterations < maxIterations) {
+        matrix.multiply(p, q);
+        const double pq = dot(p, q);
+        if (pq <= 0.0) {
+            // Not positive definite along p, CG cannot make progress
+            break;
+        }
+
+        const double alpha = rz / pq;
+        for (unsigned int i = 0; i < n; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+        }
+
+        preconditioner->apply(r, z);
+        const double rzNext = dot(r, z);
+        const double beta = rzNext / rz;
+        rz = rzNext;
+
+        for (unsigned int i = 0; i < n; i++) {
+            p[i] = z[i] + beta * p[i];
+        }
+
+        report.iterations++;
+        report.relativeResidual = std::sqrt(dot(r, r)) / scale;
+
+        if (checkpoint && checkpoint(report.iterations, report.relativeResidual)) {
+            break;
+        }
+    }
+
+    report.converged = report.relativeResidual < tolerance;
+    return report;
+}
@@ -0,0 +1,28 @@
+#ifndef CONJUGATE_GRADIENT_SOLVER_H
+#define CONJUGATE_GRADIENT_SOLVER_H
+
+#include <memory>
+
+#include "LinearSolver.h"
+#include "Preconditioner.h"
+
+// Preconditioned conjugate gradient for symmetric positive definite matrices
+// Only stores the matrix, the preconditioner and four work vectors
+class ConjugateGradientSolver : public LinearSolver {
+    SparseMatrix matrix;
+    std::unique_ptr<Preconditioner> preconditioner;
+
+    // Stop once ||r|| / ||rhs|| falls below this
+    double tolerance;
+    unsigned int maxIterations;
+
+public:
+    ConjugateGradientSolver(std::unique_ptr<Preconditioner> preconditioner, double tolerance, unsigned int maxIterations);
+
+    // Fails if the matrix is not symmetric or the preconditioner cannot be built
+    bool setup(const SparseMatrix& matrix) override;
+
+    LinearSolveReport solve(const std::vector<double>& rhs, std::vector<double>& x) const override;
+};
+
+#endif
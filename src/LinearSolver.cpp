@@ -0,0 +1,61 @@
+#include "LinearSolver.h"
+
+#include <cmath>
+
+#include "AlgebraicMultigrid.h"
+#include "BiCgStabSolver.h"
+#include "ConjugateGradientSolver.h"
+#include "SparseLUSolver.h"
+
+std::unique_ptr<Preconditioner> makePreconditioner(const PreconditionerMode mode) {
+    switch (mode) {
+        case PreconditionerMode::Jacobi:
+            return std::make_unique<JacobiPreconditioner>();
+        case PreconditionerMode::Multigrid:
+            // A single V-cycle per application, the stopping criteria are unused
+            return std::make_unique<AlgebraicMultigrid>(0.0, 1);
+        default:
+            return std::make_unique<IncompleteCholeskyPreconditioner>();
+    }
+}
+
+std::unique_ptr<LinearSolver> makeLinearSolver(const UnwrapParameters& parameters, const bool symmetric) {
+    switch (parameters.solver) {
+        case SolverMode::Direct:
+            return std::make_unique<SparseLUSolver>();
+        case SolverMode::ConjugateGradient:
+            if (!symmetric) {
+                // IC(0) needs a symmetric matrix, ILU(0) is its general counterpart
+                return std::make_unique<BiCgStabSolver>(
+                    parameters.preconditioner == PreconditionerMode::IncompleteCholesky
+                        ? std::make_unique<IncompleteLUPreconditioner>()
+                        : makePreconditioner(parameters.preconditioner),
+                    parameters.tolerance,
+                    parameters.maxIterations
+                );
+            }
+            return std::make_unique<ConjugateGradientSolver>(
+                makePreconditioner(parameters.preconditioner),
+                parameters.tolerance,
+                parameters.maxIterations
+            );
+        case SolverMode::Multigrid:
+            return std::make_unique<AlgebraicMultigrid>(parameters.tolerance, parameters.maxIterations);
+        default:
+            return nullptr;
+    }
+}
+
+double relativeResidual(const SparseMatrix& matrix, const std::vector<double>& rhs, const std::vector<double>& x) {
+    std::vector<double> residual;
+    matrix.residual(rhs, x, residual);
+
+    double residualNorm = 0.0;
+    double rhsNorm = 0.0;
+    for (unsigned int row = 0; row < matrix.size; row++) {
+        residualNorm += residual[row] * residual[row];
+        rhsNorm += rhs[row] * rhs[row];
+    }
+
+    return rhsNorm > 0.0 ? std::sqrt(residualNorm / rhsNorm) : std::sqrt(residualNorm);
+}
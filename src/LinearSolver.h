@@ -0,0 +1,58 @@
+#ifndef LINEAR_SOLVER_H
+#define LINEAR_SOLVER_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Preconditioner.h"
+#include "SparseMatrix.h"
+#include "UnwrapParameters.h"
+
+// Outcome of a single LinearSolver::solve call
+class LinearSolveReport {
+public:
+    unsigned int iterations;
+    // ||rhs - matrix * x|| / ||rhs||
+    double relativeResidual;
+    bool converged;
+
+    LinearSolveReport()
+        : iterations(0),
+          relativeResidual(0.0),
+          converged(false) {
+    }
+};
+
+// Called by the iterative backends after every iteration, with the iterations so far and the relative residual
+// Returning true stops the solve there
+typedef std::function<bool(unsigned int, double)> IterationCheckpoint;
+
+// Backend for the interior system of Floater's parameterisation
+// setup() is called once per matrix, solve() once per right-hand side (u and v)
+class LinearSolver {
+public:
+    // Unset by default, direct backends never call it
+    IterationCheckpoint checkpoint;
+
+    virtual ~LinearSolver() = default;
+
+    // Prepares the solver for matrix (factorisation, preconditioner, ...)
+    // Returns false if the matrix cannot be handled by this backend
+    virtual bool setup(const SparseMatrix& matrix) = 0;
+
+    // Solves matrix * x = rhs, x holds the initial guess on entry
+    virtual LinearSolveReport solve(const std::vector<double>& rhs, std::vector<double>& x) const = 0;
+};
+
+// Returns the preconditioner matching mode
+std::unique_ptr<Preconditioner> makePreconditioner(PreconditionerMode mode);
+
+// Returns the backend selected by parameters.solver, or nullptr for the built-in relaxation
+// Conjugate gradient needs a symmetric matrix, BiCGSTAB takes its place for the others
+std::unique_ptr<LinearSolver> makeLinearSolver(const UnwrapParameters& parameters, bool symmetric);
+
+// ||rhs - matrix * x|| / ||rhs||, or ||rhs - matrix * x|| if rhs is zero
+double relativeResidual(const SparseMatrix& matrix, const std::vector<double>& rhs, const std::vector<double>& x);
+
+#endif
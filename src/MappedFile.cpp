@@ -0,0 +1,72 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_MMAP
+#endif
+
+MappedFile::MappedFile(const std::string& path)
+    : contents(nullptr),
+      length(0),
+      mapped(false),
+      opened(false) {
+#ifdef MAPPED_FILE_MMAP
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor >= 0) {
+        struct stat status;
+        if (::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+            void* address = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address != MAP_FAILED) {
+                // Parsers read front to back, let the kernel read ahead aggressively
+                ::madvise(address, status.st_size, MADV_SEQUENTIAL);
+                contents = static_cast<const char*>(address);
+                length = status.st_size;
+                mapped = true;
+                opened = true;
+            }
+        }
+        // The mapping stays valid once the descriptor is closed
+        ::close(descriptor);
+    }
+#endif
+
+    if (!mapped) {
+        std::ifstream file(path, std::ios::binary);
+        if (file.good()) {
+            buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            contents = buffer.data();
+            length = buffer.size();
+            opened = true;
+        }
+    }
+}
+
+MappedFile::~MappedFile() {
+#ifdef MAPPED_FILE_MMAP
+    if (mapped) {
+        ::munmap(const_cast<char*>(contents), length);
+    }
+#endif
+}
+
+bool MappedFile::isOpen() const {
+    return opened;
+}
+
+const char* MappedFile::begin() const {
+    return contents;
+}
+
+const char* MappedFile::end() const {
+    return contents + length;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file, memory-mapped where the platform allows it
+// Files that cannot be mapped (empty files, pipes, other platforms) are read into memory instead
+class MappedFile {
+    const char* contents;
+    size_t length;
+    bool mapped;
+    bool opened;
+    // Holds the file when it could not be mapped
+    std::vector<char> buffer;
+
+public:
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator =(const MappedFile&) = delete;
+
+    bool isOpen() const;
+
+    const char* begin() const;
+
+    const char* end() const;
+
+    size_t size() const;
+};
+
+#endif
@@ -0,0 +1,14 @@
+#include "NeighbourTable.h"
+
+NeighbourTable::NeighbourTable()
+    : firstInterior(0),
+      offsets(1, 0) {
+}
+
+unsigned int NeighbourTable::interiorCount() const {
+    return offsets.size() - 1;
+}
+
+float NeighbourTable::weight(const unsigned int entry) const {
+    return weights.empty() ? 1.0f : weights[entry];
+}
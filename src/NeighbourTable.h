@@ -0,0 +1,30 @@
+#ifndef NEIGHBOUR_TABLE_H
+#define NEIGHBOUR_TABLE_H
+
+#include <vector>
+
+// Interior adjacency of Floater's system in compressed sparse row form
+// Interior vertex firstInterior + i is adjacent to neighbours[offsets[i]..offsets[i + 1]),
+// boundary vertices included, and relaxes to their weighted average: their weighted sum times inverseWeightSum[i]
+// Neighbours of an interior vertex are listed in order around its fan
+class NeighbourTable {
+public:
+    unsigned int firstInterior;
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> neighbours;
+    // Optional per-entry weights parallel to neighbours, empty when every neighbour weighs 1
+    // Row i weighs its neighbours independently of how they weigh i, so the weights need not be symmetric
+    std::vector<float> weights;
+    // 1 / sum of the weights of row i, 1 / degree when unweighted
+    std::vector<float> inverseWeightSum;
+
+    // No interior vertices
+    NeighbourTable();
+
+    unsigned int interiorCount() const;
+
+    // Weight of neighbours[entry]
+    float weight(unsigned int entry) const;
+};
+
+#endif
@@ -0,0 +1,273 @@
+#include "ObjParser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+namespace {
+    // Number of lines of each kind in an OBJ text, found by their first word alone
+    struct ObjLineCounts {
+        size_t vertices = 0;
+        size_t colours = 0;
+        size_t normals = 0;
+        size_t textureCoords = 0;
+        size_t faces = 0;
+    };
+
+    bool isObjSpace(const char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    const char* skipSpaces(const char* cursor, const char* const lineEnd) {
+        while (cursor < lineEnd && isObjSpace(*cursor)) {
+            cursor++;
+        }
+        return cursor;
+    }
+
+    // Stops at the end of the line too
+    const char* skipWord(const char* cursor, const char* const lineEnd) {
+        while (cursor < lineEnd && !isObjSpace(*cursor) && *cursor != '\n') {
+            cursor++;
+        }
+        return cursor;
+    }
+
+    ObjLineCounts countObjLines(const char* const begin, const char* const end) {
+        ObjLineCounts counts;
+        for (const char* line = begin; line < end;) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+            if (!lineEnd) {
+                lineEnd = end;
+            }
+
+            const char* keyword = skipSpaces(line, lineEnd);
+            const size_t keywordLength = skipWord(keyword, lineEnd) - keyword;
+            if (keywordLength == 1 && keyword[0] == 'v') {
+                counts.vertices++;
+            } else if (keywordLength == 1 && keyword[0] == 'f') {
+                counts.faces++;
+            } else if (keywordLength == 2 && keyword[0] == 'v') {
+                counts.colours += keyword[1] == 'c';
+                counts.normals += keyword[1] == 'n';
+                counts.textureCoords += keyword[1] == 't';
+            }
+
+            line = lineEnd + 1;
+        }
+        return counts;
+    }
+
+    // Reads the number at cursor into value, returning the position after it or nullptr if there is none
+    // Plain decimals whose digits fit in a float mantissa, which is what OBJ exporters mostly write, take one
+    // float division of two exact values, so they round exactly as from_chars would but several times faster
+    const char* parseFloat(const char* cursor, const char* const lineEnd, float& value) {
+        static const float powersOfTen[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+        const char* start = cursor;
+        const bool negative = cursor < lineEnd && *cursor == '-';
+        if (cursor < lineEnd && (*cursor == '-' || *cursor == '+')) {
+            cursor++;
+        }
+
+        // Digits before and after the point, read as one integer
+        unsigned long long mantissa = 0;
+        unsigned int digits = 0;
+        unsigned int decimals = 0;
+        while (cursor < lineEnd && static_cast<unsigned char>(*cursor - '0') < 10) {
+            mantissa = 10 * mantissa + (*cursor - '0');
+            digits++;
+            cursor++;
+        }
+        if (cursor < lineEnd && *cursor == '.') {
+            cursor++;
+            while (cursor < lineEnd && static_cast<unsigned char>(*cursor - '0') < 10) {
+                mantissa = 10 * mantissa + (*cursor - '0');
+                decimals++;
+                cursor++;
+            }
+        }
+        digits += decimals;
+
+        const bool exponent = cursor < lineEnd && (*cursor == 'e' || *cursor == 'E');
+        if (digits == 0 || digits > 19 || exponent || mantissa > (1u << 24) || decimals > 10) {
+            // Anything else (exponents, long mantissas, inf, nan) goes through the general conversion
+            if (start < lineEnd && *start == '+') {
+                start++;
+            }
+            const std::from_chars_result result = std::from_chars(start, lineEnd, value);
+            return result.ec == std::errc() ? result.ptr : nullptr;
+        }
+
+        const float magnitude = static_cast<float>(mantissa) / powersOfTen[decimals];
+        value = negative ? -magnitude : magnitude;
+        return cursor;
+    }
+
+    // Reads up to three numbers of a line (vt lines may have two) and moves cursor past them, missing ones are 0
+    // Unlike a stream this ignores the locale and allocates nothing
+    Cartesian3 parseCartesian3(const char*& cursor, const char* const lineEnd) {
+        float values[3] = {0.0f, 0.0f, 0.0f};
+        for (float& value : values) {
+            const char* next = parseFloat(skipSpaces(cursor, lineEnd), lineEnd, value);
+            if (!next) {
+                break;
+            }
+            cursor = next;
+        }
+        return Cartesian3(values[0], values[1], values[2]);
+    }
+
+    // Stands for a corner index too large for any vertex id
+    constexpr long long OVERSIZED_INDEX = std::numeric_limits<long long>::max();
+
+    // Reads the vertex index of the next corner of an f line into index, dropping any /texture/normal indices
+    // Indices past the range of vertex ids, however many digits they have, are read as OVERSIZED_INDEX
+    // Returns the position after the corner, or nullptr once the line has no more corners
+    const char* parseFaceIndex(const char* cursor, const char* const lineEnd, long long& index) {
+        cursor = skipSpaces(cursor, lineEnd);
+        const bool negative = cursor < lineEnd && *cursor == '-';
+        if (negative) {
+            cursor++;
+        }
+
+        const char* digits = cursor;
+        index = 0;
+        while (cursor < lineEnd && static_cast<unsigned char>(*cursor - '0') < 10 && cursor - digits < 18) {
+            index = 10 * index + (*cursor - '0');
+            cursor++;
+        }
+        if (cursor == digits) {
+            return nullptr;
+        }
+        if ((cursor < lineEnd && static_cast<unsigned char>(*cursor - '0') < 10)
+            || index > std::numeric_limits<unsigned int>::max()) {
+            index = OVERSIZED_INDEX;
+            return skipWord(cursor, lineEnd);
+        }
+        if (negative) {
+            index = -index;
+        }
+        return skipWord(cursor, lineEnd);
+    }
+}
+
+ObjChunk::ObjChunk()
+    : largestVertex(-1),
+      smallestRelativeVertex(0),
+      zeroIndex(false),
+      oversizedIndex(false) {
+}
+
+void ObjChunk::parse(const char* const begin, const char* const end) {
+    const ObjLineCounts counts = countObjLines(begin, end);
+    vertices.reserve(counts.vertices);
+    colours.reserve(counts.colours);
+    normals.reserve(counts.normals);
+    textureCoords.reserve(counts.textureCoords);
+    faceVertices.reserve(3 * counts.faces);
+    faceGroups.reserve(counts.faces);
+
+    unsigned int group = 0;
+
+    // Numbers end at the newline by themselves, so lines are parsed straight off the text and
+    // only the rest of each line is searched for its end
+    for (const char* line = begin; line < end;) {
+        const char* keyword = skipSpaces(line, end);
+        const char* cursor = skipWord(keyword, end);
+        const size_t keywordLength = cursor - keyword;
+
+        if (keywordLength == 1 && keyword[0] == 'v') {
+            vertices.push_back(parseCartesian3(cursor, end));
+        } else if (keywordLength == 2 && keyword[0] == 'v') {
+            if (keyword[1] == 'c') {
+                colours.push_back(parseCartesian3(cursor, end));
+            } else if (keyword[1] == 'n') {
+                normals.push_back(parseCartesian3(cursor, end));
+            } else if (keyword[1] == 't') {
+                textureCoords.push_back(parseCartesian3(cursor, end));
+            }
+        } else if (keywordLength == 1 && (keyword[0] == 'g' || keyword[0] == 'o')) {
+            // Group or object, the faces that follow belong to it
+            const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+            if (!lineEnd) {
+                lineEnd = end;
+            }
+            const char* name = skipSpaces(cursor, lineEnd);
+            const char* nameEnd = lineEnd;
+            while (nameEnd > name && isObjSpace(nameEnd[-1])) {
+                nameEnd--;
+            }
+            groupNames.emplace_back(name, nameEnd);
+            group = groupNames.size();
+            cursor = lineEnd;
+        } else if (keywordLength == 1 && keyword[0] == 'f') {
+            // Polygons are split into a fan of triangles around their first corner
+            unsigned int first = 0;
+            unsigned int previous = 0;
+            bool firstRelative = false;
+            bool previousRelative = false;
+            unsigned int corners = 0;
+            long long index;
+            while (const char* next = parseFaceIndex(cursor, end, index)) {
+                cursor = next;
+                if (index == OVERSIZED_INDEX) {
+                    oversizedIndex = true;
+                    break;
+                }
+
+                // Negative indices count back from the latest vertex
+                const bool relative = index < 0;
+                long long vertexId;
+                if (relative) {
+                    vertexId = static_cast<long long>(vertices.size()) + index;
+                    smallestRelativeVertex = std::min(smallestRelativeVertex, vertexId);
+                } else {
+                    vertexId = index - 1;
+                    largestVertex = std::max(largestVertex, vertexId);
+                    zeroIndex |= index == 0;
+                }
+
+                if (corners == 0) {
+                    first = static_cast<unsigned int>(vertexId);
+                    firstRelative = relative;
+                } else if (corners >= 2) {
+                    if (firstRelative) {
+                        relativeCorners.push_back(faceVertices.size());
+                    }
+                    faceVertices.push_back(first);
+                    if (previousRelative) {
+                        relativeCorners.push_back(faceVertices.size());
+                    }
+                    faceVertices.push_back(previous);
+                    if (relative) {
+                        relativeCorners.push_back(faceVertices.size());
+                    }
+                    faceVertices.push_back(static_cast<unsigned int>(vertexId));
+                    faceGroups.push_back(group);
+                }
+                previous = static_cast<unsigned int>(vertexId);
+                previousRelative = relative;
+                corners++;
+            }
+        }
+        // Anything else (comments, smoothing groups, materials) is skipped
+
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        line = lineEnd ? lineEnd + 1 : end;
+    }
+}
+
+std::vector<const char*> splitObjText(const char* const begin, const char* const end, const unsigned int count) {
+    std::vector<const char*> bounds{begin};
+    const size_t length = end - begin;
+    for (unsigned int c = 1; c < count; c++) {
+        // Move the even split forward to the start of the next line
+        const char* split = std::max(bounds.back(), begin + length / count * c);
+        const char* newline = static_cast<const char*>(std::memchr(split, '\n', end - split));
+        bounds.push_back(newline ? newline + 1 : end);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
@@ -0,0 +1,51 @@
+#ifndef OBJ_PARSER_H
+#define OBJ_PARSER_H
+
+#include <string>
+#include <vector>
+
+#include "Cartesian3.h"
+
+// Smallest part of an OBJ text worth a thread of its own
+#define OBJ_CHUNK_BYTES (1u << 20)
+
+// Everything a run of whole lines of an OBJ text lists, parsed without looking at the rest of the text
+// Chunks of one text are parsed on separate threads and then merged in order by TriangleMesh::readFromObjText
+class ObjChunk {
+public:
+    std::vector<Cartesian3> vertices;
+    std::vector<Cartesian3> colours;
+    std::vector<Cartesian3> normals;
+    std::vector<Cartesian3> textureCoords;
+    // Three corners per triangle, polygons split into a fan around their first corner
+    // Corners are 0-based vertex ids of the whole text, except those listed in relativeCorners
+    std::vector<unsigned int> faceVertices;
+    // Corners given by a negative index, held as ids counted from the first vertex of the chunk
+    // They wrap around below 0 if they refer back past its start, and are offset once the chunk is merged
+    std::vector<size_t> relativeCorners;
+    // Group of every triangle: 0 for the group in effect where the chunk starts, g for groupNames[g - 1]
+    std::vector<unsigned int> faceGroups;
+    // Names of the g and o lines of the chunk, in order, repeats included
+    std::vector<std::string> groupNames;
+
+    // Largest id of a corner outside relativeCorners, -1 if there is none
+    long long largestVertex;
+    // Most negative id in relativeCorners, 0 if there is none
+    long long smallestRelativeVertex;
+    // Whether a corner has index 0, which no vertex has
+    bool zeroIndex;
+    // Whether a corner index is too large for a vertex id, the rest of its face is then dropped
+    bool oversizedIndex;
+
+    ObjChunk();
+
+    // Parses the lines of [begin, end), which must start at a line start and end after a newline or at the end
+    // A first counting pass sizes every buffer, so the parse never reallocates
+    void parse(const char* begin, const char* end);
+};
+
+// Splits [begin, end) into count runs of whole lines of about the same length, some possibly empty
+// Returns the count + 1 bounds of the runs
+std::vector<const char*> splitObjText(const char* begin, const char* end, unsigned int count);
+
+#endif
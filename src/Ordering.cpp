@@ -0,0 +1,371 @@
+#include "Ordering.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+// Subsets at or below this size are not split any further
+#define DISSECTION_LEAF_SIZE 64
+
+// Bits per axis when quantising points onto a space-filling curve, 3 * 21 fits in a 64-bit key
+#define CURVE_BITS 21
+
+namespace {
+    constexpr unsigned int UNVISITED = std::numeric_limits<unsigned int>::max();
+
+    // A subset of vertices waiting to be ordered into positions [first, first + vertices.size())
+    struct Subset {
+        std::vector<unsigned int> vertices;
+        unsigned int first;
+    };
+
+    // Breadth-first search restricted to vertices whose subsetOf matches subsetId
+    // Fills level (per vertex) and returns the visit order, which may not cover the subset if it is disconnected
+    std::vector<unsigned int> levelStructure(
+        const SparseMatrix& matrix,
+        const unsigned int root,
+        const std::vector<unsigned int>& subsetOf,
+        const unsigned int subsetId,
+        std::vector<unsigned int>& level
+    ) {
+        std::vector<unsigned int> visited{root};
+        level[root] = 0;
+
+        for (unsigned int head = 0; head < visited.size(); head++) {
+            const unsigned int vertex = visited[head];
+
+            for (unsigned int entry = matrix.rowOffsets[vertex]; entry < matrix.rowOffsets[vertex + 1]; entry++) {
+                const unsigned int neighbour = matrix.columns[entry];
+
+                if (subsetOf[neighbour] == subsetId && level[neighbour] == UNVISITED) {
+                    level[neighbour] = level[vertex] + 1;
+                    visited.push_back(neighbour);
+                }
+            }
+        }
+
+        return visited;
+    }
+
+    // Number of interior neighbours of interior row i
+    unsigned int interiorDegree(const NeighbourTable& table, const unsigned int i) {
+        unsigned int degree = 0;
+        for (unsigned int entry = table.offsets[i]; entry < table.offsets[i + 1]; entry++) {
+            degree += table.neighbours[entry] >= table.firstInterior;
+        }
+        return degree;
+    }
+
+    // Breadth-first search over the interior rows of table, appending the visit order to visited
+    // Neighbours are queued by increasing degree (Cuthill-McKee), level is filled per row
+    void cuthillMcKeeSearch(
+        const NeighbourTable& table,
+        const std::vector<unsigned int>& degree,
+        const unsigned int root,
+        std::vector<unsigned int>& level,
+        std::vector<unsigned int>& visited
+    ) {
+        std::vector<unsigned int> children;
+        const unsigned int first = visited.size();
+        visited.push_back(root);
+        level[root] = 0;
+
+        for (unsigned int head = first; head < visited.size(); head++) {
+            const unsigned int row = visited[head];
+
+            children.clear();
+            for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+                if (table.neighbours[entry] < table.firstInterior) {
+                    continue;
+                }
+
+                const unsigned int neighbour = table.neighbours[entry] - table.firstInterior;
+                if (level[neighbour] == UNVISITED) {
+                    level[neighbour] = level[row] + 1;
+                    children.push_back(neighbour);
+                }
+            }
+
+            std::sort(children.begin(), children.end(), [&](const unsigned int a, const unsigned int b) {
+                return degree[a] < degree[b];
+            });
+            visited.insert(visited.end(), children.begin(), children.end());
+        }
+    }
+
+    // Scales every coordinate of points into [0, 2^CURVE_BITS) over their bounding box
+    std::vector<std::uint32_t> quantise(const std::vector<Cartesian3>& points) {
+        std::vector<std::uint32_t> cells(3 * points.size());
+        if (points.empty()) {
+            return cells;
+        }
+
+        Cartesian3 lower = points.front();
+        Cartesian3 upper = points.front();
+        for (const auto& point : points) {
+            for (int axis = 0; axis < 3; axis++) {
+                lower[axis] = std::min(lower[axis], point[axis]);
+                upper[axis] = std::max(upper[axis], point[axis]);
+            }
+        }
+
+        // One scale for all axes keeps the cells cubic
+        const float extent = std::max({upper.x - lower.x, upper.y - lower.y, upper.z - lower.z});
+        const double scale = extent > 0.0f ? ((1u << CURVE_BITS) - 1) / static_cast<double>(extent) : 0.0;
+
+        for (unsigned int p = 0; p < points.size(); p++) {
+            for (int axis = 0; axis < 3; axis++) {
+                cells[3 * p + axis] = static_cast<std::uint32_t>((points[p][axis] - lower[axis]) * scale);
+            }
+        }
+
+        return cells;
+    }
+
+    // Order of the keys, ties broken by index so the result is deterministic
+    std::vector<unsigned int> sortByKey(const std::vector<std::uint64_t>& keys) {
+        std::vector<std::pair<std::uint64_t, unsigned int>> keyed(keys.size());
+        for (unsigned int i = 0; i < keys.size(); i++) {
+            keyed[i] = {keys[i], i};
+        }
+        std::sort(keyed.begin(), keyed.end());
+
+        std::vector<unsigned int> order(keys.size());
+        for (unsigned int i = 0; i < keys.size(); i++) {
+            order[i] = keyed[i].second;
+        }
+        return order;
+    }
+
+    // Spreads the low CURVE_BITS bits of x two bits apart
+    std::uint64_t spreadBits(const std::uint64_t x) {
+        std::uint64_t spread = x & 0x1fffff;
+        spread = (spread | spread << 32) & 0x1f00000000ffff;
+        spread = (spread | spread << 16) & 0x1f0000ff0000ff;
+        spread = (spread | spread << 8) & 0x100f00f00f00f00f;
+        spread = (spread | spread << 4) & 0x10c30c30c30c30c3;
+        spread = (spread | spread << 2) & 0x1249249249249249;
+        return spread;
+    }
+}
+
+std::vector<unsigned int> nestedDissectionOrdering(const SparseMatrix& matrix) {
+    const unsigned int n = matrix.size;
+    std::vector<unsigned int> order(n);
+
+    // Each vertex remembers which pending subset it belongs to, so searches stay inside it
+    std::vector<unsigned int> subsetOf(n, 0);
+    std::vector<unsigned int> level(n, UNVISITED);
+    unsigned int nextSubsetId = 1;
+
+    std::vector<Subset> pending;
+    pending.push_back({std::vector<unsigned int>(n), 0});
+    for (unsigned int v = 0; v < n; v++) {
+        pending.back().vertices[v] = v;
+    }
+
+    while (!pending.empty()) {
+        Subset subset = std::move(pending.back());
+        pending.pop_back();
+
+        if (subset.vertices.empty()) {
+            continue;
+        }
+
+        if (subset.vertices.size() <= DISSECTION_LEAF_SIZE) {
+            for (unsigned int i = 0; i < subset.vertices.size(); i++) {
+                order[subset.first + i] = subset.vertices[i];
+            }
+            continue;
+        }
+
+        const unsigned int subsetId = subsetOf[subset.vertices.front()];
+
+        // Two sweeps find a pseudo-peripheral root, which gives long and thin level sets
+        std::vector<unsigned int> visited = levelStructure(matrix, subset.vertices.front(), subsetOf, subsetId, level);
+        const unsigned int root = visited.back();
+        for (const unsigned int vertex : visited) {
+            level[vertex] = UNVISITED;
+        }
+        visited = levelStructure(matrix, root, subsetOf, subsetId, level);
+
+        Subset reached{{}, subset.first};
+        Subset separator{{}, 0};
+        Subset beyond{{}, 0};
+        Subset unreached{{}, 0};
+
+        if (visited.size() < subset.vertices.size()) {
+            // Disconnected subset: split off the component that was reached, no separator needed
+            reached.vertices = visited;
+        } else {
+            // Separate on the level that halves the subset
+            const unsigned int separatorLevel = level[visited[visited.size() / 2]];
+
+            for (const unsigned int vertex : visited) {
+                if (level[vertex] < separatorLevel) {
+                    reached.vertices.push_back(vertex);
+                } else if (level[vertex] == separatorLevel) {
+                    separator.vertices.push_back(vertex);
+                } else {
+                    beyond.vertices.push_back(vertex);
+                }
+            }
+        }
+
+        for (const unsigned int vertex : subset.vertices) {
+            if (level[vertex] == UNVISITED) {
+                unreached.vertices.push_back(vertex);
+            }
+        }
+        for (const unsigned int vertex : visited) {
+            level[vertex] = UNVISITED;
+        }
+
+        // Halves come first, the separator that couples them is eliminated last
+        beyond.first = reached.first + reached.vertices.size();
+        unreached.first = beyond.first + beyond.vertices.size();
+        separator.first = unreached.first + unreached.vertices.size();
+
+        for (unsigned int i = 0; i < separator.vertices.size(); i++) {
+            order[separator.first + i] = separator.vertices[i];
+        }
+
+        for (Subset* part : {&reached, &beyond, &unreached}) {
+            const unsigned int partId = nextSubsetId++;
+            for (const unsigned int vertex : part->vertices) {
+                subsetOf[vertex] = partId;
+            }
+            pending.push_back(std::move(*part));
+        }
+    }
+
+    return order;
+}
+
+std::vector<std::vector<unsigned int>> greedyColourClasses(const NeighbourTable& table) {
+    const unsigned int n = table.interiorCount();
+    const unsigned int offset = table.firstInterior;
+    std::vector<unsigned int> colour(n, UNVISITED);
+    std::vector<std::vector<unsigned int>> colourClasses;
+
+    // usedBy[c] == i marks colour c as taken by a neighbour of i
+    std::vector<unsigned int> usedBy;
+
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int entry = table.offsets[i]; entry < table.offsets[i + 1]; entry++) {
+            const unsigned int neighbour = table.neighbours[entry];
+            if (neighbour >= offset && neighbour - offset < n && colour[neighbour - offset] != UNVISITED) {
+                usedBy[colour[neighbour - offset]] = i;
+            }
+        }
+
+        unsigned int c = 0;
+        while (c < colourClasses.size() && usedBy[c] == i) {
+            c++;
+        }
+
+        if (c == colourClasses.size()) {
+            colourClasses.emplace_back();
+            usedBy.push_back(UNVISITED);
+        }
+
+        colour[i] = c;
+        colourClasses[c].push_back(i + offset);
+    }
+
+    return colourClasses;
+}
+
+std::vector<unsigned int> reverseCuthillMcKeeOrdering(const NeighbourTable& table) {
+    const unsigned int n = table.interiorCount();
+    std::vector<unsigned int> degree(n);
+    for (unsigned int i = 0; i < n; i++) {
+        degree[i] = interiorDegree(table, i);
+    }
+
+    // Components are started from their lowest degree row, so visit rows by degree
+    std::vector<unsigned int> byDegree(n);
+    for (unsigned int i = 0; i < n; i++) {
+        byDegree[i] = i;
+    }
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&](const unsigned int a, const unsigned int b) {
+        return degree[a] < degree[b];
+    });
+
+    std::vector<unsigned int> level(n, UNVISITED);
+    std::vector<unsigned int> order;
+    order.reserve(n);
+
+    for (const unsigned int start : byDegree) {
+        if (level[start] != UNVISITED) {
+            continue;
+        }
+
+        // A first search finds a pseudo-peripheral root: the last row it reached
+        const unsigned int first = order.size();
+        cuthillMcKeeSearch(table, degree, start, level, order);
+        const unsigned int root = order.back();
+        for (unsigned int k = first; k < order.size(); k++) {
+            level[order[k]] = UNVISITED;
+        }
+        order.resize(first);
+
+        cuthillMcKeeSearch(table, degree, root, level, order);
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<unsigned int> mortonOrdering(const std::vector<Cartesian3>& points) {
+    const std::vector<std::uint32_t> cells = quantise(points);
+    std::vector<std::uint64_t> keys(points.size());
+
+    for (unsigned int p = 0; p < points.size(); p++) {
+        keys[p] = spreadBits(cells[3 * p]) << 2 | spreadBits(cells[3 * p + 1]) << 1 | spreadBits(cells[3 * p + 2]);
+    }
+
+    return sortByKey(keys);
+}
+
+std::vector<unsigned int> hilbertOrdering(const std::vector<Cartesian3>& points) {
+    const std::vector<std::uint32_t> cells = quantise(points);
+    std::vector<std::uint64_t> keys(points.size());
+
+    for (unsigned int p = 0; p < points.size(); p++) {
+        std::uint32_t x[3] = {cells[3 * p], cells[3 * p + 1], cells[3 * p + 2]};
+
+        // Skilling's transform ("Programming the Hilbert curve", 2004): axes to transposed Hilbert index
+        for (std::uint32_t q = 1u << (CURVE_BITS - 1); q > 1; q >>= 1) {
+            const std::uint32_t mask = q - 1;
+            for (int axis = 0; axis < 3; axis++) {
+                if (x[axis] & q) {
+                    x[0] ^= mask;
+                } else {
+                    const std::uint32_t swap = (x[0] ^ x[axis]) & mask;
+                    x[0] ^= swap;
+                    x[axis] ^= swap;
+                }
+            }
+        }
+
+        // Gray encode
+        x[1] ^= x[0];
+        x[2] ^= x[1];
+        std::uint32_t flip = 0;
+        for (std::uint32_t q = 1u << (CURVE_BITS - 1); q > 1; q >>= 1) {
+            if (x[2] & q) {
+                flip ^= q - 1;
+            }
+        }
+        for (auto& coordinate : x) {
+            coordinate ^= flip;
+        }
+
+        // The transposed index interleaves into the key, most significant bit of x[0] first
+        keys[p] = spreadBits(x[0]) << 2 | spreadBits(x[1]) << 1 | spreadBits(x[2]);
+    }
+
+    return sortByKey(keys);
+}
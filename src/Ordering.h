@@ -0,0 +1,31 @@
+#ifndef ORDERING_H
+#define ORDERING_H
+
+#include <vector>
+
+#include "Cartesian3.h"
+#include "NeighbourTable.h"
+#include "SparseMatrix.h"
+
+// Fill-reducing elimination order for a matrix with a symmetric sparsity pattern
+// Returns order such that order[k] is the row/column eliminated k-th
+// Recursively splits the adjacency graph along breadth-first level-set separators (George's nested dissection)
+std::vector<unsigned int> nestedDissectionOrdering(const SparseMatrix& matrix);
+
+// Greedy first-fit colouring of the interior vertices of table, boundary neighbours are ignored
+// Returns the vertex ids of each colour class, no two vertices in a class are adjacent
+std::vector<std::vector<unsigned int>> greedyColourClasses(const NeighbourTable& table);
+
+// Reverse Cuthill-McKee order of the interior vertices of table, boundary neighbours are ignored
+// Returns order such that order[k] is the interior row (0-based, firstInterior excluded) placed k-th
+// Neighbours end up close together in the order, which keeps relaxation sweeps within a narrow band of memory
+std::vector<unsigned int> reverseCuthillMcKeeOrdering(const NeighbourTable& table);
+
+// Order of points along a Z-order (Morton) curve through their bounding box
+std::vector<unsigned int> mortonOrdering(const std::vector<Cartesian3>& points);
+
+// Order of points along a Hilbert curve through their bounding box
+// Unlike the Z-order curve it never jumps, so consecutive points are always in adjacent cells
+std::vector<unsigned int> hilbertOrdering(const std::vector<Cartesian3>& points);
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Below this many elements a range is processed on the calling thread
+#define PARALLEL_GRAIN_SIZE 4096
+
+// Number of worker threads to use when none is requested explicitly
+inline unsigned int hardwareThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Splits [begin, end) into one contiguous chunk per thread and calls body(chunkBegin, chunkEnd) on each
+// Chunks are disjoint, so body may write to per-element slots without synchronisation
+template <typename Body>
+void parallelFor(const unsigned int begin, const unsigned int end, Body body, unsigned int nThreads = 0) {
+    if (begin >= end) {
+        return;
+    }
+
+    if (nThreads == 0) {
+        nThreads = hardwareThreads();
+    }
+
+    const unsigned int size = end - begin;
+    nThreads = std::min(nThreads, (size + PARALLEL_GRAIN_SIZE - 1) / PARALLEL_GRAIN_SIZE);
+
+    if (nThreads <= 1) {
+        body(begin, end);
+        return;
+    }
+
+    const unsigned int chunkSize = (size + nThreads - 1) / nThreads;
+
+    std::vector<std::thread> workers;
+    workers.reserve(nThreads - 1);
+    for (unsigned int t = 1; t < nThreads; t++) {
+        const unsigned int chunkBegin = std::min(end, begin + t * chunkSize);
+        const unsigned int chunkEnd = std::min(end, chunkBegin + chunkSize);
+        workers.emplace_back(body, chunkBegin, chunkEnd);
+    }
+
+    // The calling thread takes the first chunk
+    body(begin, std::min(end, begin + chunkSize));
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Runs body(threadIndex) on nThreads threads, the calling thread being index 0, and waits for all of them
+template <typename Body>
+void runOnThreads(const unsigned int nThreads, Body body) {
+    std::vector<std::thread> workers;
+    workers.reserve(nThreads > 0 ? nThreads - 1 : 0);
+    for (unsigned int t = 1; t < nThreads; t++) {
+        workers.emplace_back(body, t);
+    }
+
+    body(0u);
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Reusable barrier for a fixed set of threads, spins briefly before yielding
+class Barrier {
+    const unsigned int count;
+    std::atomic<unsigned int> waiting;
+    std::atomic<unsigned int> generation;
+
+public:
+    explicit Barrier(const unsigned int count)
+        : count(count),
+          waiting(0),
+          generation(0) {
+    }
+
+    void arriveAndWait() {
+        const unsigned int arrivedGeneration = generation.load(std::memory_order_acquire);
+
+        if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            // Last one in releases everybody else
+            waiting.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+
+        for (unsigned int spin = 0; generation.load(std::memory_order_acquire) == arrivedGeneration; spin++) {
+            if (spin > 1024) {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "Preconditioner.h"
+
+#include <cmath>
+
+bool JacobiPreconditioner::setup(const SparseMatrix& matrix) {
+    inverseDiagonal.resize(matrix.size);
+
+    for (unsigned int row = 0; row < matrix.size; row++) {
+        const double diagonal = matrix.at(row, row);
+        if (diagonal == 0.0) {
+            return false;
+        }
+        inverseDiagonal[row] = 1.0 / diagonal;
+    }
+
+    return true;
+}
+
+void JacobiPreconditioner::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    z.resize(r.size());
+
+    for (unsigned int row = 0; row < r.size(); row++) {
+        z[row] = inverseDiagonal[row] * r[row];
+    }
+}
+
+bool IncompleteCholeskyPreconditioner::setup(const SparseMatrix& matrix) {
+    // Copy the lower triangle (including the diagonal, which is last in each sorted row)
+    lower = SparseMatrix();
+    lower.size = matrix.size;
+    lower.columnCount = matrix.size;
+    lower.rowOffsets.assign(matrix.size + 1, 0);
+
+    for (unsigned int row = 0; row < matrix.size; row++) {
+        bool hasDiagonal = false;
+
+        for (unsigned int entry = matrix.rowOffsets[row]; entry < matrix.rowOffsets[row + 1]; entry++) {
+            if (matrix.columns[entry] <= row) {
+                hasDiagonal = matrix.columns[entry] == row;
+                lower.columns.push_back(matrix.columns[entry]);
+                lower.values.push_back(matrix.values[entry]);
+            }
+        }
+
+        if (!hasDiagonal) {
+            return false;
+        }
+        lower.rowOffsets[row + 1] = lower.columns.size();
+    }
+
+    // Row-wise IC(0): L_ik = (A_ik - sum_j<k L_ij L_kj) / L_kk, L_ii = sqrt(A_ii - sum_j<i L_ij^2)
+    // Both rows are sorted, so the partial dot products are a merge
+    for (unsigned int row = 0; row < lower.size; row++) {
+        const unsigned int rowBegin = lower.rowOffsets[row];
+        const unsigned int diagonal = lower.rowOffsets[row + 1] - 1;
+
+        for (unsigned int entry = rowBegin; entry <= diagonal; entry++) {
+            const unsigned int k = lower.columns[entry];
+            const unsigned int kEnd = lower.rowOffsets[k + 1] - 1;
+
+            double sum = lower.values[entry];
+            unsigned int a = rowBegin;
+            unsigned int b = lower.rowOffsets[k];
+            while (a < entry && b < kEnd) {
+                if (lower.columns[a] < lower.columns[b]) {
+                    a++;
+                } else if (lower.columns[a] > lower.columns[b]) {
+                    b++;
+                } else {
+                    sum -= lower.values[a++] * lower.values[b++];
+                }
+            }
+
+            if (entry == diagonal) {
+                if (sum <= 0.0) {
+                    return false;
+                }
+                lower.values[entry] = std::sqrt(sum);
+            } else {
+                lower.values[entry] = sum / lower.values[kEnd];
+            }
+        }
+    }
+
+    return true;
+}
+
+void IncompleteCholeskyPreconditioner::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    z = r;
+
+    // L y = r
+    for (unsigned int row = 0; row < lower.size; row++) {
+        const unsigned int diagonal = lower.rowOffsets[row + 1] - 1;
+        for (unsigned int entry = lower.rowOffsets[row]; entry < diagonal; entry++) {
+            z[row] -= lower.values[entry] * z[lower.columns[entry]];
+        }
+        z[row] /= lower.values[diagonal];
+    }
+
+    // L^T z = y, walking the rows of L backwards scatters each solved value up its column
+    for (unsigned int row = lower.size; row-- > 0;) {
+        const unsigned int diagonal = lower.rowOffsets[row + 1] - 1;
+        z[row] /= lower.values[diagonal];
+        for (unsigned int entry = lower.rowOffsets[row]; entry < diagonal; entry++) {
+            z[lower.columns[entry]] -= lower.values[entry] * z[row];
+        }
+    }
+}
+
+bool IncompleteLUPreconditioner::setup(const SparseMatrix& matrix) {
+    factors = matrix;
+    diagonals.assign(matrix.size, 0);
+
+    for (unsigned int row = 0; row < factors.size; row++) {
+        unsigned int entry = factors.rowOffsets[row];
+        while (entry < factors.rowOffsets[row + 1] && factors.columns[entry] < row) {
+            entry++;
+        }
+        if (entry == factors.rowOffsets[row + 1] || factors.columns[entry] != row) {
+            return false;
+        }
+        diagonals[row] = entry;
+    }
+
+    // IKJ ILU(0): eliminate the lower entries of each row with the rows above, dropping any fill-in
+    // Both rows are sorted, so matching the columns right of k is a merge
+    for (unsigned int row = 0; row < factors.size; row++) {
+        const unsigned int rowEnd = factors.rowOffsets[row + 1];
+
+        for (unsigned int entry = factors.rowOffsets[row]; entry < diagonals[row]; entry++) {
+            const unsigned int k = factors.columns[entry];
+            const double pivot = factors.values[diagonals[k]];
+            if (pivot == 0.0) {
+                return false;
+            }
+            const double multiplier = factors.values[entry] / pivot;
+            factors.values[entry] = multiplier;
+
+            unsigned int a = entry + 1;
+            unsigned int b = diagonals[k] + 1;
+            while (a < rowEnd && b < factors.rowOffsets[k + 1]) {
+                if (factors.columns[a] < factors.columns[b]) {
+                    a++;
+                } else if (factors.columns[a] > factors.columns[b]) {
+                    b++;
+                } else {
+                    factors.values[a++] -= multiplier * factors.values[b++];
+                }
+            }
+        }
+
+        if (factors.values[diagonals[row]] == 0.0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void IncompleteLUPreconditioner::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    z = r;
+
+    // L y = r, L has a unit diagonal
+    for (unsigned int row = 0; row < factors.size; row++) {
+        for (unsigned int entry = factors.rowOffsets[row]; entry < diagonals[row]; entry++) {
+            z[row] -= factors.values[entry] * z[factors.columns[entry]];
+        }
+    }
+
+    // U z = y
+    for (unsigned int row = factors.size; row-- > 0;) {
+        for (unsigned int entry = diagonals[row] + 1; entry < factors.rowOffsets[row + 1]; entry++) {
+            z[row] -= factors.values[entry] * z[factors.columns[entry]];
+        }
+        z[row] /= factors.values[diagonals[row]];
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef PRECONDITIONER_H
+#define PRECONDITIONER_H
+
+#include <vector>
+
+#include "SparseMatrix.h"
+
+// Approximate inverse M^-1 of a matrix, applied once per Krylov iteration
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+
+    // Returns false if the preconditioner cannot be built for matrix
+    virtual bool setup(const SparseMatrix& matrix) = 0;
+
+    // z = M^-1 r
+    virtual void apply(const std::vector<double>& r, std::vector<double>& z) const = 0;
+};
+
+// M = diag(A)
+class JacobiPreconditioner : public Preconditioner {
+    std::vector<double> inverseDiagonal;
+
+public:
+    bool setup(const SparseMatrix& matrix) override;
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override;
+};
+
+// M = L L^T where L keeps the pattern of the lower triangle of A, IC(0)
+// Requires a symmetric matrix, setup fails if a pivot breaks down
+class IncompleteCholeskyPreconditioner : public Preconditioner {
+    // Row r of L holds columns[rowOffsets[r]..rowOffsets[r + 1]) ending with the diagonal
+    SparseMatrix lower;
+
+public:
+    bool setup(const SparseMatrix& matrix) override;
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override;
+};
+
+// M = L U where L (unit lower) and U keep the pattern of A, ILU(0)
+// The non-symmetric counterpart of IC(0), setup fails if a pivot vanishes
+class IncompleteLUPreconditioner : public Preconditioner {
+    // L below the diagonal and U from it onwards, in the pattern of A
+    SparseMatrix factors;
+    // Entry of the diagonal in every row of factors
+    std::vector<unsigned int> diagonals;
+
+public:
+    bool setup(const SparseMatrix& matrix) override;
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override;
+};
+
+#endif
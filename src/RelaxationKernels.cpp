@@ -0,0 +1,723 @@
+#include "RelaxationKernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+
+// Vector kernels are compiled per function with target attributes and picked at runtime,
+// so the rest of the build keeps its baseline instruction set
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RELAXATION_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+// Sweeps timed per kernel by fastestIsa
+#define CALIBRATION_SWEEPS 2
+
+// How many rows ahead relaxRangePrefetched requests neighbour UVs
+#define PREFETCH_DISTANCE 8
+
+// Fully unrolls the neighbour loops of the fixed-valence kernels
+#if defined(__GNUC__) || defined(__clang__)
+#define UNROLL_VALENCE _Pragma("GCC unroll 8")
+#else
+#define UNROLL_VALENCE
+#endif
+
+SweepStatistics::SweepStatistics()
+    : maxDisplacementSquared(0.0f),
+      sumDisplacementSquared(0.0) {
+}
+
+void SweepStatistics::merge(const SweepStatistics& other) {
+    maxDisplacementSquared = std::max(maxDisplacementSquared, other.maxDisplacementSquared);
+    sumDisplacementSquared += other.sumDisplacementSquared;
+}
+
+ValenceBucket::ValenceBucket(const unsigned int valence)
+    : valence(valence) {
+}
+
+namespace {
+    // Weight of neighbours[entry], known to be 1 at compile time for unweighted tables
+    template <bool Weighted>
+    inline float entryWeight(const NeighbourTable& table, const unsigned int entry) {
+        return Weighted ? table.weights[entry] : 1.0f;
+    }
+
+    // Calls body(std::true_type()) for weighted tables and body(std::false_type()) otherwise,
+    // so the scalar kernels test the weighting at compile time rather than per neighbour
+    template <typename Body>
+    inline SweepStatistics withWeighting(const NeighbourTable& table, Body body) {
+        return table.weights.empty() ? body(std::false_type()) : body(std::true_type());
+    }
+
+    // Calls body(std::integral_constant<unsigned int, valence>()) for the unrolled valences,
+    // and body(std::integral_constant<unsigned int, 0>()) for any other
+    template <typename Body>
+    inline void withValence(const unsigned int valence, Body body) {
+        switch (valence) {
+            case 4:
+                body(std::integral_constant<unsigned int, 4>());
+                break;
+            case 5:
+                body(std::integral_constant<unsigned int, 5>());
+                break;
+            case 6:
+                body(std::integral_constant<unsigned int, 6>());
+                break;
+            case 7:
+                body(std::integral_constant<unsigned int, 7>());
+                break;
+            case 8:
+                body(std::integral_constant<unsigned int, 8>());
+                break;
+            default:
+                body(std::integral_constant<unsigned int, 0>());
+                break;
+        }
+    }
+
+    // Neighbour count of interior row, a compile-time constant unless Valence is 0
+    template <unsigned int Valence>
+    inline unsigned int valenceOf(const NeighbourTable& table, const unsigned int row) {
+        return Valence != 0 ? Valence : table.offsets[row + 1] - table.offsets[row];
+    }
+
+    // 1 / weight sum of interior row, a compile-time constant for a known valence without weights
+    template <unsigned int Valence, bool Weighted>
+    inline float inverseWeightSumOf(const NeighbourTable& table, const unsigned int row) {
+        if constexpr (Valence != 0 && !Weighted) {
+            return 1.0f / Valence;
+        } else {
+            return table.inverseWeightSum[row];
+        }
+    }
+
+    // Weighted average of the UVs around interior row
+    // A non-zero Valence promises the row has that many neighbours, which unrolls the loop
+    template <unsigned int Valence, bool Weighted>
+    inline void neighbourAverage(
+        const NeighbourTable& table,
+        const unsigned int row,
+        const float* u,
+        const float* v,
+        float& averageU,
+        float& averageV
+    ) {
+        const unsigned int first = table.offsets[row];
+        const unsigned int valence = valenceOf<Valence>(table, row);
+        float sumU = 0.0f;
+        float sumV = 0.0f;
+
+        UNROLL_VALENCE
+        for (unsigned int k = 0; k < valence; k++) {
+            const float weight = entryWeight<Weighted>(table, first + k);
+            sumU += weight * u[table.neighbours[first + k]];
+            sumV += weight * v[table.neighbours[first + k]];
+        }
+
+        averageU = sumU * inverseWeightSumOf<Valence, Weighted>(table, row);
+        averageV = sumV * inverseWeightSumOf<Valence, Weighted>(table, row);
+    }
+
+    // Relaxes a single vertex, shared by every kernel for scalar work and remainders
+    template <unsigned int Valence, bool Weighted>
+    inline void relaxVertex(
+        const NeighbourTable& table,
+        const unsigned int vertex,
+        float* u,
+        float* v,
+        SweepStatistics& statistics
+    ) {
+        float newU;
+        float newV;
+        neighbourAverage<Valence, Weighted>(table, vertex - table.firstInterior, u, v, newU, newV);
+        const float du = newU - u[vertex];
+        const float dv = newV - v[vertex];
+        const float displacementSquared = du * du + dv * dv;
+
+        statistics.maxDisplacementSquared = std::max(statistics.maxDisplacementSquared, displacementSquared);
+        statistics.sumDisplacementSquared += displacementSquared;
+
+        u[vertex] = newU;
+        v[vertex] = newV;
+    }
+
+    template <unsigned int Valence, bool Weighted>
+    SweepStatistics relaxIndependentScalar(
+        const NeighbourTable& table,
+        const unsigned int* vertices,
+        const unsigned int count,
+        float* u,
+        float* v
+    ) {
+        SweepStatistics statistics;
+
+        for (unsigned int c = 0; c < count; c++) {
+            relaxVertex<Valence, Weighted>(table, vertices[c], u, v, statistics);
+        }
+
+        return statistics;
+    }
+
+#ifdef RELAXATION_X86_KERNELS
+    // SSE2 has no gathers: lanes are filled one load at a time, only the arithmetic is vectorised
+    template <unsigned int Valence, bool Weighted>
+    __attribute__((target("sse2")))
+    SweepStatistics relaxIndependentSse(
+        const NeighbourTable& table,
+        const unsigned int* vertices,
+        const unsigned int count,
+        float* u,
+        float* v
+    ) {
+        constexpr unsigned int LANES = 4;
+        SweepStatistics statistics;
+        __m128 maxDisplacementSquared = _mm_setzero_ps();
+        alignas(16) float lanes[2][LANES];
+
+        unsigned int c = 0;
+        for (; c + LANES <= count; c += LANES) {
+            __m128 sumU = _mm_setzero_ps();
+            __m128 sumV = _mm_setzero_ps();
+            unsigned int begin[LANES];
+            unsigned int end[LANES];
+            unsigned int maxDegree = 0;
+
+            for (unsigned int lane = 0; lane < LANES; lane++) {
+                const unsigned int row = vertices[c + lane] - table.firstInterior;
+                begin[lane] = table.offsets[row];
+                end[lane] = table.offsets[row + 1];
+                maxDegree = std::max(maxDegree, end[lane] - begin[lane]);
+            }
+
+            const unsigned int neighbourCount = Valence != 0 ? Valence : maxDegree;
+            UNROLL_VALENCE
+            for (unsigned int k = 0; k < neighbourCount; k++) {
+                for (unsigned int lane = 0; lane < LANES; lane++) {
+                    const unsigned int entry = begin[lane] + k;
+                    const bool active = Valence != 0 || entry < end[lane];
+                    const float weight = active ? entryWeight<Weighted>(table, entry) : 0.0f;
+                    lanes[0][lane] = active ? weight * u[table.neighbours[entry]] : 0.0f;
+                    lanes[1][lane] = active ? weight * v[table.neighbours[entry]] : 0.0f;
+                }
+                sumU = _mm_add_ps(sumU, _mm_load_ps(lanes[0]));
+                sumV = _mm_add_ps(sumV, _mm_load_ps(lanes[1]));
+            }
+
+            const unsigned int* ids = vertices + c;
+            const __m128 inverseWeightSum = _mm_setr_ps(
+                inverseWeightSumOf<Valence, Weighted>(table, ids[0] - table.firstInterior),
+                inverseWeightSumOf<Valence, Weighted>(table, ids[1] - table.firstInterior),
+                inverseWeightSumOf<Valence, Weighted>(table, ids[2] - table.firstInterior),
+                inverseWeightSumOf<Valence, Weighted>(table, ids[3] - table.firstInterior)
+            );
+            const __m128 newU = _mm_mul_ps(sumU, inverseWeightSum);
+            const __m128 newV = _mm_mul_ps(sumV, inverseWeightSum);
+            const __m128 du = _mm_sub_ps(newU, _mm_setr_ps(u[ids[0]], u[ids[1]], u[ids[2]], u[ids[3]]));
+            const __m128 dv = _mm_sub_ps(newV, _mm_setr_ps(v[ids[0]], v[ids[1]], v[ids[2]], v[ids[3]]));
+            const __m128 displacementSquared = _mm_add_ps(_mm_mul_ps(du, du), _mm_mul_ps(dv, dv));
+            maxDisplacementSquared = _mm_max_ps(maxDisplacementSquared, displacementSquared);
+
+            _mm_store_ps(lanes[0], newU);
+            _mm_store_ps(lanes[1], newV);
+            alignas(16) float displacement[LANES];
+            _mm_store_ps(displacement, displacementSquared);
+            for (unsigned int lane = 0; lane < LANES; lane++) {
+                u[ids[lane]] = lanes[0][lane];
+                v[ids[lane]] = lanes[1][lane];
+                statistics.sumDisplacementSquared += displacement[lane];
+            }
+        }
+
+        alignas(16) float maxLanes[LANES];
+        _mm_store_ps(maxLanes, maxDisplacementSquared);
+        statistics.maxDisplacementSquared = *std::max_element(maxLanes, maxLanes + LANES);
+
+        for (; c < count; c++) {
+            relaxVertex<Valence, Weighted>(table, vertices[c], u, v, statistics);
+        }
+
+        return statistics;
+    }
+
+    // 8 vertices per iteration, neighbours fetched with gathers, masked unless every lane has Valence of them
+    template <unsigned int Valence, bool Weighted>
+    __attribute__((target("avx2")))
+    SweepStatistics relaxIndependentAvx2(
+        const NeighbourTable& table,
+        const unsigned int* vertices,
+        const unsigned int count,
+        float* u,
+        float* v
+    ) {
+        constexpr unsigned int LANES = 8;
+        SweepStatistics statistics;
+
+        const int* offsets = reinterpret_cast<const int*>(table.offsets.data());
+        const int* neighbours = reinterpret_cast<const int*>(table.neighbours.data());
+        const __m256i firstInterior = _mm256_set1_epi32(static_cast<int>(table.firstInterior));
+        __m256 maxDisplacementSquared = _mm256_setzero_ps();
+        alignas(32) float lanes[3][LANES];
+
+        unsigned int c = 0;
+        for (; c + LANES <= count; c += LANES) {
+            const __m256i ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vertices + c));
+            const __m256i rows = _mm256_sub_epi32(ids, firstInterior);
+            const __m256i begin = _mm256_i32gather_epi32(offsets, rows, 4);
+
+            __m256 sumU = _mm256_setzero_ps();
+            __m256 sumV = _mm256_setzero_ps();
+            if constexpr (Valence != 0) {
+                UNROLL_VALENCE
+                for (unsigned int k = 0; k < Valence; k++) {
+                    const __m256i entry = _mm256_add_epi32(begin, _mm256_set1_epi32(static_cast<int>(k)));
+                    const __m256i neighbour = _mm256_i32gather_epi32(neighbours, entry, 4);
+                    __m256 neighbourU = _mm256_i32gather_ps(u, neighbour, 4);
+                    __m256 neighbourV = _mm256_i32gather_ps(v, neighbour, 4);
+                    if (Weighted) {
+                        const __m256 weight = _mm256_i32gather_ps(table.weights.data(), entry, 4);
+                        neighbourU = _mm256_mul_ps(weight, neighbourU);
+                        neighbourV = _mm256_mul_ps(weight, neighbourV);
+                    }
+                    sumU = _mm256_add_ps(sumU, neighbourU);
+                    sumV = _mm256_add_ps(sumV, neighbourV);
+                }
+            } else {
+                const __m256i degree = _mm256_sub_epi32(_mm256_i32gather_epi32(offsets + 1, rows, 4), begin);
+
+                // Horizontal max of the degrees bounds the neighbour loop
+                __m256i maxDegree = _mm256_max_epi32(degree, _mm256_permute2x128_si256(degree, degree, 1));
+                maxDegree = _mm256_max_epi32(maxDegree, _mm256_shuffle_epi32(maxDegree, 0x4e));
+                maxDegree = _mm256_max_epi32(maxDegree, _mm256_shuffle_epi32(maxDegree, 0xb1));
+                const int neighbourCount = _mm256_cvtsi256_si32(maxDegree);
+
+                for (int k = 0; k < neighbourCount; k++) {
+                    const __m256i kk = _mm256_set1_epi32(k);
+                    const __m256i active = _mm256_cmpgt_epi32(degree, kk);
+                    const __m256i entry = _mm256_add_epi32(begin, kk);
+                    const __m256i neighbour = _mm256_mask_i32gather_epi32(
+                        _mm256_setzero_si256(), neighbours, entry, active, 4
+                    );
+                    __m256 neighbourU = _mm256_mask_i32gather_ps(
+                        _mm256_setzero_ps(), u, neighbour, _mm256_castsi256_ps(active), 4
+                    );
+                    __m256 neighbourV = _mm256_mask_i32gather_ps(
+                        _mm256_setzero_ps(), v, neighbour, _mm256_castsi256_ps(active), 4
+                    );
+                    if (Weighted) {
+                        const __m256 weight = _mm256_mask_i32gather_ps(
+                            _mm256_setzero_ps(), table.weights.data(), entry, _mm256_castsi256_ps(active), 4
+                        );
+                        neighbourU = _mm256_mul_ps(weight, neighbourU);
+                        neighbourV = _mm256_mul_ps(weight, neighbourV);
+                    }
+                    sumU = _mm256_add_ps(sumU, neighbourU);
+                    sumV = _mm256_add_ps(sumV, neighbourV);
+                }
+            }
+
+            const __m256 inverseWeightSum = Valence != 0 && !Weighted
+                                                ? _mm256_set1_ps(inverseWeightSumOf<Valence, Weighted>(table, 0))
+                                                : _mm256_i32gather_ps(table.inverseWeightSum.data(), rows, 4);
+            const __m256 newU = _mm256_mul_ps(sumU, inverseWeightSum);
+            const __m256 newV = _mm256_mul_ps(sumV, inverseWeightSum);
+            const __m256 du = _mm256_sub_ps(newU, _mm256_i32gather_ps(u, ids, 4));
+            const __m256 dv = _mm256_sub_ps(newV, _mm256_i32gather_ps(v, ids, 4));
+            const __m256 displacementSquared = _mm256_add_ps(_mm256_mul_ps(du, du), _mm256_mul_ps(dv, dv));
+            maxDisplacementSquared = _mm256_max_ps(maxDisplacementSquared, displacementSquared);
+
+            // AVX2 has no scatter
+            _mm256_store_ps(lanes[0], newU);
+            _mm256_store_ps(lanes[1], newV);
+            _mm256_store_ps(lanes[2], displacementSquared);
+            for (unsigned int lane = 0; lane < LANES; lane++) {
+                u[vertices[c + lane]] = lanes[0][lane];
+                v[vertices[c + lane]] = lanes[1][lane];
+                statistics.sumDisplacementSquared += lanes[2][lane];
+            }
+        }
+
+        _mm256_store_ps(lanes[0], maxDisplacementSquared);
+        statistics.maxDisplacementSquared = *std::max_element(lanes[0], lanes[0] + LANES);
+
+        for (; c < count; c++) {
+            relaxVertex<Valence, Weighted>(table, vertices[c], u, v, statistics);
+        }
+
+        return statistics;
+    }
+
+    // 16 vertices per iteration, gathers in and scatters out, masked unless every lane has Valence neighbours
+    template <unsigned int Valence, bool Weighted>
+    __attribute__((target("avx512f")))
+    SweepStatistics relaxIndependentAvx512(
+        const NeighbourTable& table,
+        const unsigned int* vertices,
+        const unsigned int count,
+        float* u,
+        float* v
+    ) {
+        constexpr unsigned int LANES = 16;
+        SweepStatistics statistics;
+
+        const int* offsets = reinterpret_cast<const int*>(table.offsets.data());
+        const int* neighbours = reinterpret_cast<const int*>(table.neighbours.data());
+        const __m512i firstInterior = _mm512_set1_epi32(static_cast<int>(table.firstInterior));
+        const __mmask16 all = 0xffff;
+        __m512 maxDisplacementSquared = _mm512_setzero_ps();
+        alignas(64) int degrees[LANES];
+        alignas(64) float lanes[LANES];
+
+        unsigned int c = 0;
+        for (; c + LANES <= count; c += LANES) {
+            const __m512i ids = _mm512_loadu_si512(vertices + c);
+            const __m512i rows = _mm512_sub_epi32(ids, firstInterior);
+            const __m512i begin = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), all, rows, offsets, 4);
+
+            __mmask16 active = all;
+            __m512i degree = _mm512_set1_epi32(static_cast<int>(Valence));
+            int neighbourCount = static_cast<int>(Valence);
+            if constexpr (Valence == 0) {
+                degree = _mm512_sub_epi32(
+                    _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), all, rows, offsets + 1, 4), begin
+                );
+                _mm512_store_si512(degrees, degree);
+                neighbourCount = *std::max_element(degrees, degrees + LANES);
+            }
+
+            __m512 sumU = _mm512_setzero_ps();
+            __m512 sumV = _mm512_setzero_ps();
+            UNROLL_VALENCE
+            for (int k = 0; k < neighbourCount; k++) {
+                const __m512i kk = _mm512_set1_epi32(k);
+                if constexpr (Valence == 0) {
+                    active = _mm512_cmpgt_epi32_mask(degree, kk);
+                }
+                const __m512i entry = _mm512_add_epi32(begin, kk);
+                const __m512i neighbour = _mm512_mask_i32gather_epi32(
+                    _mm512_setzero_si512(), active, entry, neighbours, 4
+                );
+                __m512 neighbourU = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), active, neighbour, u, 4);
+                __m512 neighbourV = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), active, neighbour, v, 4);
+                if (Weighted) {
+                    const __m512 weight = _mm512_mask_i32gather_ps(
+                        _mm512_setzero_ps(), active, entry, table.weights.data(), 4
+                    );
+                    neighbourU = _mm512_mul_ps(weight, neighbourU);
+                    neighbourV = _mm512_mul_ps(weight, neighbourV);
+                }
+                sumU = _mm512_add_ps(sumU, neighbourU);
+                sumV = _mm512_add_ps(sumV, neighbourV);
+            }
+
+            const __m512 inverseWeightSum = Valence != 0 && !Weighted
+                                                ? _mm512_set1_ps(inverseWeightSumOf<Valence, Weighted>(table, 0))
+                                                : _mm512_mask_i32gather_ps(
+                                                      _mm512_setzero_ps(), all, rows, table.inverseWeightSum.data(), 4
+                                                  );
+            const __m512 newU = _mm512_mul_ps(sumU, inverseWeightSum);
+            const __m512 newV = _mm512_mul_ps(sumV, inverseWeightSum);
+            const __m512 du = _mm512_sub_ps(newU, _mm512_mask_i32gather_ps(_mm512_setzero_ps(), all, ids, u, 4));
+            const __m512 dv = _mm512_sub_ps(newV, _mm512_mask_i32gather_ps(_mm512_setzero_ps(), all, ids, v, 4));
+            const __m512 displacementSquared = _mm512_add_ps(_mm512_mul_ps(du, du), _mm512_mul_ps(dv, dv));
+            maxDisplacementSquared = _mm512_mask_max_ps(maxDisplacementSquared, all, maxDisplacementSquared, displacementSquared);
+
+            _mm512_i32scatter_ps(u, ids, newU, 4);
+            _mm512_i32scatter_ps(v, ids, newV, 4);
+
+            _mm512_store_ps(lanes, displacementSquared);
+            for (unsigned int lane = 0; lane < LANES; lane++) {
+                statistics.sumDisplacementSquared += lanes[lane];
+            }
+        }
+
+        _mm512_store_ps(lanes, maxDisplacementSquared);
+        statistics.maxDisplacementSquared = *std::max_element(lanes, lanes + LANES);
+
+        for (; c < count; c++) {
+            relaxVertex<Valence, Weighted>(table, vertices[c], u, v, statistics);
+        }
+
+        return statistics;
+    }
+#endif
+
+    // Kernel for isa, specialised for Valence and Weighted
+    template <unsigned int Valence, bool Weighted>
+    IndependentRelaxationKernel specialisedKernel(const KernelIsa isa) {
+#ifdef RELAXATION_X86_KERNELS
+        switch (isa) {
+            case KernelIsa::SSE:
+                return relaxIndependentSse<Valence, Weighted>;
+            case KernelIsa::AVX2:
+                return relaxIndependentAvx2<Valence, Weighted>;
+            case KernelIsa::AVX512:
+                return relaxIndependentAvx512<Valence, Weighted>;
+            default:
+                break;
+        }
+#else
+        static_cast<void>(isa);
+#endif
+
+        return relaxIndependentScalar<Valence, Weighted>;
+    }
+}
+
+SweepStatistics relaxRange(
+    const NeighbourTable& table,
+    const unsigned int begin,
+    const unsigned int end,
+    float* u,
+    float* v
+) {
+    return withWeighting(table, [&](const auto weighted) {
+        SweepStatistics statistics;
+
+        for (unsigned int vertex = begin; vertex < end; vertex++) {
+            relaxVertex<0, decltype(weighted)::value>(table, vertex, u, v, statistics);
+        }
+
+        return statistics;
+    });
+}
+
+SweepStatistics relaxRangeOverRelaxed(
+    const NeighbourTable& table,
+    const unsigned int begin,
+    const unsigned int end,
+    const float omega,
+    float* u,
+    float* v
+) {
+    return withWeighting(table, [&](const auto weighted) {
+        SweepStatistics statistics;
+
+        for (unsigned int vertex = begin; vertex < end; vertex++) {
+            float averageU;
+            float averageV;
+            neighbourAverage<0, decltype(weighted)::value>(table, vertex - table.firstInterior, u, v, averageU, averageV);
+
+            // Overshoot the average by omega
+            const float du = omega * (averageU - u[vertex]);
+            const float dv = omega * (averageV - v[vertex]);
+            const float displacementSquared = du * du + dv * dv;
+
+            statistics.maxDisplacementSquared = std::max(statistics.maxDisplacementSquared, displacementSquared);
+            statistics.sumDisplacementSquared += displacementSquared;
+
+            u[vertex] += du;
+            v[vertex] += dv;
+        }
+
+        return statistics;
+    });
+}
+
+SweepStatistics relaxRangePrefetched(
+    const NeighbourTable& table,
+    const unsigned int begin,
+    const unsigned int end,
+    float* u,
+    float* v
+) {
+    return withWeighting(table, [&](const auto weighted) {
+        SweepStatistics statistics;
+
+        for (unsigned int vertex = begin; vertex < end; vertex++) {
+#if defined(__GNUC__) || defined(__clang__)
+            // Neighbour indices are streamed, the UVs they point at are not, so fetch those early
+            if (vertex + PREFETCH_DISTANCE < end) {
+                const unsigned int row = vertex + PREFETCH_DISTANCE - table.firstInterior;
+                for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+                    __builtin_prefetch(u + table.neighbours[entry], 1);
+                    __builtin_prefetch(v + table.neighbours[entry], 1);
+                }
+            }
+#endif
+            relaxVertex<0, decltype(weighted)::value>(table, vertex, u, v, statistics);
+        }
+
+        return statistics;
+    });
+}
+
+SweepStatistics relaxCorrectionRange(
+    const NeighbourTable& table,
+    const unsigned int begin,
+    const unsigned int end,
+    const float* ru,
+    const float* rv,
+    float* eu,
+    float* ev
+) {
+    return withWeighting(table, [&](const auto weighted) {
+        SweepStatistics statistics;
+
+        for (unsigned int vertex = begin; vertex < end; vertex++) {
+            const unsigned int row = vertex - table.firstInterior;
+            float averageU;
+            float averageV;
+            neighbourAverage<0, decltype(weighted)::value>(table, row, eu, ev, averageU, averageV);
+
+            const float newU = averageU + ru[row];
+            const float newV = averageV + rv[row];
+            const float du = newU - eu[vertex];
+            const float dv = newV - ev[vertex];
+            const float displacementSquared = du * du + dv * dv;
+
+            statistics.maxDisplacementSquared = std::max(statistics.maxDisplacementSquared, displacementSquared);
+            statistics.sumDisplacementSquared += displacementSquared;
+
+            eu[vertex] = newU;
+            ev[vertex] = newV;
+        }
+
+        return statistics;
+    });
+}
+
+double floaterResidual(const NeighbourTable& table, const double* u, const double* v, double* ru, double* rv) {
+    double maxResidualSquared = 0.0;
+
+    for (unsigned int row = 0; row < table.interiorCount(); row++) {
+        double sumU = 0.0;
+        double sumV = 0.0;
+        double sumWeights = 0.0;
+
+        for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+            const double weight = table.weight(entry);
+            sumU += weight * u[table.neighbours[entry]];
+            sumV += weight * v[table.neighbours[entry]];
+            sumWeights += weight;
+        }
+
+        // Divided in double rather than by the float inverseWeightSum, which would shift the solution by its rounding
+        ru[row] = sumU / sumWeights - u[table.firstInterior + row];
+        rv[row] = sumV / sumWeights - v[table.firstInterior + row];
+        maxResidualSquared = std::max(maxResidualSquared, ru[row] * ru[row] + rv[row] * rv[row]);
+    }
+
+    return std::sqrt(maxResidualSquared);
+}
+
+bool isaSupported(const KernelIsa isa) {
+#ifdef RELAXATION_X86_KERNELS
+    switch (isa) {
+        case KernelIsa::Scalar:
+            return true;
+        case KernelIsa::SSE:
+            // Part of every x86-64 target, but not of every 32-bit one
+            return __builtin_cpu_supports("sse2");
+        case KernelIsa::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case KernelIsa::AVX512:
+            return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return isa == KernelIsa::Scalar;
+#endif
+}
+
+KernelIsa bestSupportedIsa() {
+    for (const KernelIsa isa : {KernelIsa::AVX512, KernelIsa::AVX2, KernelIsa::SSE}) {
+        if (isaSupported(isa)) {
+            return isa;
+        }
+    }
+
+    return KernelIsa::Scalar;
+}
+
+const char* isaName(const KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::SSE:
+            return "SSE";
+        case KernelIsa::AVX2:
+            return "AVX2";
+        case KernelIsa::AVX512:
+            return "AVX-512";
+        default:
+            return "scalar";
+    }
+}
+
+IndependentRelaxationKernel independentRelaxationKernel(
+    const KernelIsa isa,
+    const bool weighted,
+    const unsigned int valence
+) {
+    IndependentRelaxationKernel kernel = nullptr;
+
+    withValence(valence, [&](const auto fixedValence) {
+        kernel = weighted
+                     ? specialisedKernel<decltype(fixedValence)::value, true>(isa)
+                     : specialisedKernel<decltype(fixedValence)::value, false>(isa);
+    });
+
+    return kernel;
+}
+
+std::vector<ValenceBucket> bucketByValence(const NeighbourTable& table, const std::vector<unsigned int>& vertices) {
+    std::vector<ValenceBucket> buckets;
+    // Bucket of each unrolled valence, then the generic one
+    std::vector<int> bucketOf(MAX_UNROLLED_VALENCE + 1, -1);
+
+    for (const unsigned int vertex : vertices) {
+        const unsigned int row = vertex - table.firstInterior;
+        unsigned int valence = table.offsets[row + 1] - table.offsets[row];
+        if (valence < MIN_UNROLLED_VALENCE || valence > MAX_UNROLLED_VALENCE) {
+            valence = 0;
+        }
+
+        if (bucketOf[valence] < 0) {
+            bucketOf[valence] = static_cast<int>(buckets.size());
+            buckets.emplace_back(valence);
+        }
+        buckets[bucketOf[valence]].vertices.push_back(vertex);
+    }
+
+    return buckets;
+}
+
+KernelIsa fastestIsa(
+    const NeighbourTable& table,
+    const std::vector<std::vector<ValenceBucket>>& colourClasses,
+    const std::vector<float>& u,
+    const std::vector<float>& v
+) {
+    KernelIsa fastest = KernelIsa::Scalar;
+    auto fastestTime = std::chrono::steady_clock::duration::max();
+
+    for (const KernelIsa isa : {KernelIsa::Scalar, KernelIsa::SSE, KernelIsa::AVX2, KernelIsa::AVX512}) {
+        if (!isaSupported(isa)) {
+            continue;
+        }
+
+        std::vector<float> scratchU = u;
+        std::vector<float> scratchV = v;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int sweep = 0; sweep < CALIBRATION_SWEEPS; sweep++) {
+            for (const auto& colourClass : colourClasses) {
+                for (const ValenceBucket& bucket : colourClass) {
+                    const IndependentRelaxationKernel kernel =
+                        independentRelaxationKernel(isa, !table.weights.empty(), bucket.valence);
+                    kernel(table, bucket.vertices.data(), bucket.vertices.size(), scratchU.data(), scratchV.data());
+                }
+            }
+        }
+
+        if (const auto elapsed = std::chrono::steady_clock::now() - start;
+            elapsed < fastestTime) {
+            fastestTime = elapsed;
+            fastest = isa;
+        }
+    }
+
+    return fastest;
+}
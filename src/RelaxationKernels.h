@@ -0,0 +1,117 @@
+#ifndef RELAXATION_KERNELS_H
+#define RELAXATION_KERNELS_H
+
+#include <vector>
+
+#include "NeighbourTable.h"
+
+// UV displacement gathered while relaxing a set of vertices
+class SweepStatistics {
+public:
+    float maxDisplacementSquared;
+    double sumDisplacementSquared;
+
+    SweepStatistics();
+
+    void merge(const SweepStatistics& other);
+};
+
+// Valences with fully unrolled kernels, the others go to the generic ones
+// Covers the valence 6 of regular triangulations and the 4..8 of most remeshed and scanned surfaces
+#define MIN_UNROLLED_VALENCE 4
+#define MAX_UNROLLED_VALENCE 8
+
+// Instruction sets with a relaxation kernel, in increasing order of width
+enum class KernelIsa {
+    Scalar,
+    SSE,
+    AVX2,
+    AVX512
+};
+
+// In-place Gauss-Seidel update of interior vertices [begin, end), in index order
+// u and v are indexed by vertex, boundary vertices included
+SweepStatistics relaxRange(const NeighbourTable& table, unsigned int begin, unsigned int end, float* u, float* v);
+
+// Successive over-relaxation: every vertex moves omega times as far as relaxRange would move it
+SweepStatistics relaxRangeOverRelaxed(
+    const NeighbourTable& table,
+    unsigned int begin,
+    unsigned int end,
+    float omega,
+    float* u,
+    float* v
+);
+
+// relaxRange with software prefetches for the neighbours of upcoming vertices
+// Worth it when the neighbour UVs are unlikely to be cached, e.g. on the first sweep over a tile
+SweepStatistics relaxRangePrefetched(
+    const NeighbourTable& table,
+    unsigned int begin,
+    unsigned int end,
+    float* u,
+    float* v
+);
+
+// Gauss-Seidel update of the correction equations e = average(e) + r over interior vertices [begin, end)
+// ru and rv are indexed by interior row, eu and ev by vertex and hold 0 on the boundary
+// Corrections are small, so float keeps their relative precision where it cannot for the UVs themselves
+SweepStatistics relaxCorrectionRange(
+    const NeighbourTable& table,
+    unsigned int begin,
+    unsigned int end,
+    const float* ru,
+    const float* rv,
+    float* eu,
+    float* ev
+);
+
+// Residuals average(x) - x of every interior row, in double precision, into ru and rv (indexed by row)
+// u and v are indexed by vertex; returns the largest UV residual
+double floaterResidual(const NeighbourTable& table, const double* u, const double* v, double* ru, double* rv);
+
+// In-place update of vertices[0..count), which must be pairwise non-adjacent (e.g. one colour class)
+// Independence lets the vector kernels update one vertex per lane
+typedef SweepStatistics (*IndependentRelaxationKernel)(
+    const NeighbourTable& table,
+    const unsigned int* vertices,
+    unsigned int count,
+    float* u,
+    float* v
+);
+
+// Widest instruction set the running CPU supports
+KernelIsa bestSupportedIsa();
+
+bool isaSupported(KernelIsa isa);
+
+const char* isaName(KernelIsa isa);
+
+// Vertices of one colour class sharing a neighbour count
+class ValenceBucket {
+public:
+    // In [MIN_UNROLLED_VALENCE, MAX_UNROLLED_VALENCE], or 0 for the vertices of any other valence
+    unsigned int valence;
+    std::vector<unsigned int> vertices;
+
+    explicit ValenceBucket(unsigned int valence);
+};
+
+// Returns the kernel for isa, which must be supported, specialised for tables with or without weights
+// A non-zero valence gives a kernel unrolled for vertices with exactly that many neighbours
+IndependentRelaxationKernel independentRelaxationKernel(KernelIsa isa, bool weighted, unsigned int valence = 0);
+
+// Splits vertices into buckets by valence, keeping their order within a bucket
+std::vector<ValenceBucket> bucketByValence(const NeighbourTable& table, const std::vector<unsigned int>& vertices);
+
+// Times a couple of sweeps of every supported kernel over the bucketed colour classes, on copies of u and v,
+// and returns the fastest
+// Gather throughput varies a lot between CPUs, so the widest instruction set is not always the best
+KernelIsa fastestIsa(
+    const NeighbourTable& table,
+    const std::vector<std::vector<ValenceBucket>>& colourClasses,
+    const std::vector<float>& u,
+    const std::vector<float>& v
+);
+
+#endif
@@ -57,6 +57,8 @@ RenderController::RenderController(
                      this, SLOT(writeUnwrappedObj()));
     QObject::connect(renderWindow->writeToPng, SIGNAL(released()),
                      this, SLOT(writeToPng()));
+    QObject::connect(renderWindow->stopUnwrapButton, SIGNAL(released()),
+                     this, SLOT(stopUnwrap()));
 
     // copy the rotation matrix from the widgets to the model
     renderParameters->rotationMatrix = renderWindow->modelRotator->rotationMatrix();
@@ -137,6 +139,11 @@ void RenderController::writeToPng() const {
     renderWindow->resetInterface();
 }
 
+void RenderController::stopUnwrap() const {
+    std::cout << "Stopping the unwrap..." << std::endl;
+    renderWindow->renderWidget->stopUnwrap();
+}
+
 void RenderController::beginScaledDrag(const int whichButton, const float x, const float y) {
     // Remember drag button
     dragButton = whichButton;
@@ -48,6 +48,9 @@ public slots:
 
     void writeToPng() const;
 
+    // slot for cancelling the background unwrap
+    void stopUnwrap() const;
+
     // slots for responding to arcball manipulations
     // these are general purpose signals which pass the mouse moves to the controller
     // after scaling to the notional unit sphere
@@ -1,6 +1,7 @@
 #include "RenderWidget.h"
 
 #include <cmath>
+#include <iostream>
 
 #ifdef __APPLE__
 #include <OpenGL/gl.h>
@@ -11,13 +12,55 @@
 #define REMAP_TO_UNIT_INTERVAL(x) (0.5 + (0.5 * x))
 #define REMAP_FROM_UNIT_INTERVAL(x) (-1.0 + (2.0 * x))
 
+// How often the widget looks for new UV snapshots while unwrapping
+#define UNWRAP_POLL_INTERVAL_MS 30
+
 RenderWidget::RenderWidget(
     TriangleMesh* triangleMesh,
     RenderParameters* renderParameters,
+    UnwrapWorker* unwrapWorker,
     QWidget* parent
 ) : QOpenGLWidget(parent),
     renderParameters(renderParameters),
+    unwrapWorker(unwrapWorker),
+    unwrapPollTimer(nullptr),
     triangleMesh(triangleMesh) {
+    if (unwrapWorker) {
+        // Drawn at UV (0, 0) until the first snapshot arrives
+        triangleMesh->textureCoords.resize(triangleMesh->vertices.size());
+
+        unwrapPollTimer = new QTimer(this);
+        connect(unwrapPollTimer, SIGNAL(timeout()), this, SLOT(pollUnwrap()));
+        unwrapPollTimer->start(UNWRAP_POLL_INTERVAL_MS);
+    }
+}
+
+bool RenderWidget::isUnwrapping() const {
+    return unwrapWorker != nullptr;
+}
+
+void RenderWidget::stopUnwrap() const {
+    if (unwrapWorker) {
+        unwrapWorker->cancel();
+    }
+}
+
+void RenderWidget::pollUnwrap() {
+    if (!unwrapWorker) {
+        return;
+    }
+
+    if (unwrapWorker->finished()) {
+        *triangleMesh = unwrapWorker->takeMesh();
+        unwrapWorker = nullptr;
+        unwrapPollTimer->stop();
+
+        std::cout << "Finished unwrapping" << std::endl;
+        emit unwrapFinished();
+        update();
+    } else if (unwrapWorker->snapshots.take(triangleMesh->textureCoords)) {
+        update();
+    }
 }
 
 void RenderWidget::initializeGL() {
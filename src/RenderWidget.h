@@ -3,9 +3,11 @@
 
 #include <QOpenGLWidget>
 #include <QMouseEvent>
+#include <QTimer>
 
 #include "TriangleMesh.h"
 #include "RenderParameters.h"
+#include "UnwrapWorker.h"
 
 // class for a render widget with arcball linked to an external arcball widget
 class RenderWidget : public QOpenGLWidget {
@@ -13,15 +15,31 @@ class RenderWidget : public QOpenGLWidget {
 
     RenderParameters* renderParameters;
 
+    // Unwrap running in the background, or nullptr once it has finished
+    UnwrapWorker* unwrapWorker;
+    QTimer* unwrapPollTimer;
+
 public:
     TriangleMesh* triangleMesh;
 
+    // If unwrapWorker is given, the UVs of triangleMesh follow its snapshots until it finishes
+    // and then triangleMesh is replaced by the unwrapped mesh
     RenderWidget(
         TriangleMesh* triangleMesh,
         RenderParameters* renderParameters,
+        UnwrapWorker* unwrapWorker,
         QWidget* parent
     );
 
+    bool isUnwrapping() const;
+
+    // Cancels the running unwrap, which then finishes with the UVs reached so far
+    void stopUnwrap() const;
+
+public slots:
+    // Picks up the latest snapshot, or the finished mesh, from the unwrap worker
+    void pollUnwrap();
+
 protected:
     void initializeGL();
 
@@ -46,6 +64,9 @@ signals:
     void continueScaledDrag(float x, float y);
 
     void endScaledDrag(float x, float y);
+
+    // Emitted once triangleMesh holds the finished unwrap
+    void unwrapFinished();
 };
 
 #endif
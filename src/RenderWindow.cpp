@@ -5,6 +5,7 @@
 RenderWindow::RenderWindow(
     TriangleMesh* triangleMesh,
     RenderParameters* renderParameters,
+    UnwrapWorker* unwrapWorker,
     const char* windowName
 ) : QWidget(nullptr),
     triangleMesh(triangleMesh),
@@ -13,7 +14,7 @@ RenderWindow::RenderWindow(
 
     windowLayout = new QGridLayout(this);
 
-    renderWidget = new RenderWidget(triangleMesh, renderParameters, this);
+    renderWidget = new RenderWidget(triangleMesh, renderParameters, unwrapWorker, this);
 
     modelRotator = new ArcBallWidget(this);
 
@@ -25,6 +26,7 @@ RenderWindow::RenderWindow(
 
     writeUnwrappedObjFile = new QPushButton("Write unwrap .obj", this);
     writeToPng = new QPushButton("Render to .png", this);
+    stopUnwrapButton = new QPushButton("Stop unwrap", this);
 
     xTranslateSlider = new QSlider(Qt::Horizontal, this);
     yTranslateSlider = new QSlider(Qt::Vertical, this);
@@ -51,6 +53,7 @@ RenderWindow::RenderWindow(
     windowLayout->addWidget(renderTextureBox, 6, 3, 1, 1);
     windowLayout->addWidget(writeUnwrappedObjFile, 7, 3, 1, 1);
     windowLayout->addWidget(writeToPng, 8, 3, 1, 1);
+    windowLayout->addWidget(stopUnwrapButton, 9, 3, 1, 1);
 
     // Translate Slider Row
     windowLayout->addWidget(xTranslateSlider, nStacked, 1, 1, 1);
@@ -58,6 +61,14 @@ RenderWindow::RenderWindow(
     // nothing in column 3
     windowLayout->addWidget(zoomLabel, nStacked, 4, 1, 1);
 
+    // Partial UVs are only for show, they are not written out
+    writeUnwrappedObjFile->setEnabled(!renderWidget->isUnwrapping());
+    stopUnwrapButton->setEnabled(renderWidget->isUnwrapping());
+    connect(renderWidget, &RenderWidget::unwrapFinished, writeUnwrappedObjFile, [this] {
+        writeUnwrappedObjFile->setEnabled(true);
+        stopUnwrapButton->setEnabled(false);
+    });
+
     resetInterface();
 }
 
@@ -98,4 +109,5 @@ void RenderWindow::resetInterface() const {
     useTexCoordsBox->update();
     renderTextureBox->update();
     writeToPng->update();
+    stopUnwrapButton->update();
 }
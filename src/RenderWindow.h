@@ -6,6 +6,7 @@
 #include "ArcBallWidget.h"
 #include "RenderWidget.h"
 #include "TriangleMesh.h"
+#include "UnwrapWorker.h"
 
 // window that displays a geometric model with controls
 class RenderWindow : public QWidget {
@@ -26,6 +27,7 @@ class RenderWindow : public QWidget {
 
     QPushButton* writeUnwrappedObjFile;
     QPushButton* writeToPng;
+    QPushButton* stopUnwrapButton;
 
     QSlider* xTranslateSlider;
     QSlider* yTranslateSlider;
@@ -36,9 +38,11 @@ class RenderWindow : public QWidget {
     QLabel* zoomLabel;
 
 public:
+    // Shows triangleMesh straight away, and its UVs as unwrapWorker (if any) converges
     RenderWindow(
         TriangleMesh* triangleMesh,
         RenderParameters* renderParameters,
+        UnwrapWorker* unwrapWorker = nullptr,
         const char* windowName = "Mesh Viewer"
     );
 
@@ -0,0 +1,179 @@
+#include "SparseLUSolver.h"
+
+#include <cmath>
+#include <limits>
+
+#include "Ordering.h"
+
+namespace {
+    constexpr unsigned int NO_PARENT = std::numeric_limits<unsigned int>::max();
+}
+
+bool SparseLUSolver::setup(const SparseMatrix& matrix) {
+    this->matrix = matrix;
+    const unsigned int n = matrix.size;
+
+    order = nestedDissectionOrdering(matrix);
+    position.resize(n);
+    for (unsigned int k = 0; k < n; k++) {
+        position[order[k]] = k;
+    }
+
+    std::vector<unsigned int> parent;
+    std::vector<unsigned int> columnCounts;
+    analyse(parent, columnCounts);
+
+    lowerOffsets.assign(n + 1, 0);
+    for (unsigned int k = 0; k < n; k++) {
+        lowerOffsets[k + 1] = lowerOffsets[k] + columnCounts[k];
+    }
+    lowerRows.resize(lowerOffsets[n]);
+    lowerValues.resize(lowerOffsets[n]);
+    upperValues.resize(lowerOffsets[n]);
+    diagonal.assign(n, 0.0);
+
+    // Up-looking factorisation: row k of L and column k of U come from two sparse triangular solves
+    // Both share the pattern given by the elimination tree reach of row/column k
+    const SparseMatrix transposed = matrix.transpose();
+    std::vector<unsigned int> nextEntry(lowerOffsets.begin(), lowerOffsets.end() - 1);
+    std::vector<double> column(n, 0.0);
+    std::vector<double> row(n, 0.0);
+    std::vector<unsigned int> flag(n, NO_PARENT);
+    std::vector<unsigned int> pattern(n);
+    std::vector<unsigned int> stack(n);
+
+    for (unsigned int k = 0; k < n; k++) {
+        unsigned int top = n;
+        flag[k] = k;
+
+        const auto scatter = [&](const SparseMatrix& source, std::vector<double>& target) {
+            for (unsigned int entry = source.rowOffsets[order[k]]; entry < source.rowOffsets[order[k] + 1]; entry++) {
+                unsigned int i = position[source.columns[entry]];
+
+                if (i > k) {
+                    continue;
+                }
+                if (i == k) {
+                    diagonal[k] = source.values[entry];
+                    continue;
+                }
+
+                target[i] += source.values[entry];
+
+                // Walk up the elimination tree, pushing the path in topological order
+                unsigned int length = 0;
+                while (flag[i] != k) {
+                    stack[length++] = i;
+                    flag[i] = k;
+                    i = parent[i];
+                }
+                while (length > 0) {
+                    pattern[--top] = stack[--length];
+                }
+            }
+        };
+
+        // row holds C(k, 0..k-1), column holds C(0..k-1, k) where C = P A P^T
+        scatter(matrix, row);
+        scatter(transposed, column);
+
+        for (unsigned int p = top; p < n; p++) {
+            const unsigned int i = pattern[p];
+            const double yi = column[i];
+            const double zi = row[i];
+            column[i] = 0.0;
+            row[i] = 0.0;
+
+            for (unsigned int entry = lowerOffsets[i]; entry < nextEntry[i]; entry++) {
+                column[lowerRows[entry]] -= lowerValues[entry] * yi;
+                row[lowerRows[entry]] -= upperValues[entry] * zi;
+            }
+
+            const double lower = zi / diagonal[i];
+            const double upper = yi / diagonal[i];
+            diagonal[k] -= lower * yi;
+
+            const unsigned int entry = nextEntry[i]++;
+            lowerRows[entry] = k;
+            lowerValues[entry] = lower;
+            upperValues[entry] = upper;
+        }
+
+        if (diagonal[k] == 0.0 || !std::isfinite(diagonal[k])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SparseLUSolver::analyse(std::vector<unsigned int>& parent, std::vector<unsigned int>& columnCounts) const {
+    const unsigned int n = matrix.size;
+    const SparseMatrix transposed = matrix.transpose();
+
+    parent.assign(n, NO_PARENT);
+    columnCounts.assign(n, 0);
+    std::vector<unsigned int> flag(n, NO_PARENT);
+
+    for (unsigned int k = 0; k < n; k++) {
+        flag[k] = k;
+
+        // Entries of both row and column k, in case the pattern is not exactly symmetric
+        for (const SparseMatrix* source : {&matrix, &transposed}) {
+            for (unsigned int entry = source->rowOffsets[order[k]]; entry < source->rowOffsets[order[k] + 1]; entry++) {
+                unsigned int i = position[source->columns[entry]];
+
+                while (i < k && flag[i] != k) {
+                    if (parent[i] == NO_PARENT) {
+                        parent[i] = k;
+                    }
+                    columnCounts[i]++;
+                    flag[i] = k;
+                    i = parent[i];
+                }
+            }
+        }
+    }
+}
+
+LinearSolveReport SparseLUSolver::solve(const std::vector<double>& rhs, std::vector<double>& x) const {
+    const unsigned int n = matrix.size;
+    std::vector<double> permuted(n);
+    for (unsigned int k = 0; k < n; k++) {
+        permuted[k] = rhs[order[k]];
+    }
+
+    // L y = P rhs
+    for (unsigned int j = 0; j < n; j++) {
+        for (unsigned int entry = lowerOffsets[j]; entry < lowerOffsets[j + 1]; entry++) {
+            permuted[lowerRows[entry]] -= lowerValues[entry] * permuted[j];
+        }
+    }
+
+    // D z = y
+    for (unsigned int j = 0; j < n; j++) {
+        permuted[j] /= diagonal[j];
+    }
+
+    // U w = z
+    for (unsigned int j = n; j-- > 0;) {
+        for (unsigned int entry = lowerOffsets[j]; entry < lowerOffsets[j + 1]; entry++) {
+            permuted[j] -= upperValues[entry] * permuted[lowerRows[entry]];
+        }
+    }
+
+    x.resize(n);
+    for (unsigned int k = 0; k < n; k++) {
+        x[order[k]] = permuted[k];
+    }
+
+    LinearSolveReport report;
+    report.iterations = 1;
+    report.relativeResidual = relativeResidual(matrix, rhs, x);
+    report.converged = std::isfinite(report.relativeResidual);
+    return report;
+}
+
+unsigned int SparseLUSolver::factorNonZeros() const {
+    return lowerRows.size();
+}
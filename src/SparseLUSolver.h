@@ -0,0 +1,40 @@
+#ifndef SPARSE_LU_SOLVER_H
+#define SPARSE_LU_SOLVER_H
+
+#include <vector>
+
+#include "LinearSolver.h"
+
+// Direct solver computing P A P^T = L D U for matrices with a symmetric sparsity pattern
+// Values need not be symmetric, if they are then U = L^T and this is an LDL^T (Cholesky) factorisation
+// P is a nested dissection ordering, the pattern of L is found up front from the elimination tree
+// No pivoting is done: meant for diagonally dominant systems such as Floater's
+class SparseLUSolver : public LinearSolver {
+    SparseMatrix matrix;
+
+    // order[k] is the original row eliminated k-th, position is its inverse
+    std::vector<unsigned int> order;
+    std::vector<unsigned int> position;
+
+    // Column k of L holds rows lowerRows[lowerOffsets[k]..lowerOffsets[k + 1])
+    // Row k of U shares the same pattern (as columns), hence the shared index arrays
+    std::vector<unsigned int> lowerOffsets;
+    std::vector<unsigned int> lowerRows;
+    std::vector<double> lowerValues;
+    std::vector<double> upperValues;
+    std::vector<double> diagonal;
+
+public:
+    bool setup(const SparseMatrix& matrix) override;
+
+    LinearSolveReport solve(const std::vector<double>& rhs, std::vector<double>& x) const override;
+
+    // Number of stored off-diagonal entries in L (equally in U)
+    unsigned int factorNonZeros() const;
+
+private:
+    // Computes the elimination tree and the number of entries per column of L
+    void analyse(std::vector<unsigned int>& parent, std::vector<unsigned int>& columnCounts) const;
+};
+
+#endif
@@ -0,0 +1,181 @@
+#include "SparseMatrix.h"
+
+#include <algorithm>
+
+SparseMatrix::SparseMatrix()
+    : size(0),
+      columnCount(0),
+      rowOffsets(1, 0) {
+}
+
+SparseMatrix::SparseMatrix(
+    const unsigned int size,
+    const std::vector<unsigned int>& tripletRows,
+    const std::vector<unsigned int>& tripletColumns,
+    const std::vector<double>& tripletValues
+) : SparseMatrix(size, size, tripletRows, tripletColumns, tripletValues) {
+}
+
+SparseMatrix::SparseMatrix(
+    const unsigned int size,
+    const unsigned int columnCount,
+    const std::vector<unsigned int>& tripletRows,
+    const std::vector<unsigned int>& tripletColumns,
+    const std::vector<double>& tripletValues
+) : size(size),
+    columnCount(columnCount),
+    rowOffsets(size + 1, 0) {
+    // Counting sort triplets into rows
+    for (const unsigned int row : tripletRows) {
+        rowOffsets[row + 1]++;
+    }
+    for (unsigned int row = 0; row < size; row++) {
+        rowOffsets[row + 1] += rowOffsets[row];
+    }
+
+    std::vector<unsigned int> unsortedColumns(tripletRows.size());
+    std::vector<double> unsortedValues(tripletRows.size());
+    std::vector<unsigned int> insertAt(rowOffsets.begin(), rowOffsets.end() - 1);
+    for (unsigned int t = 0; t < tripletRows.size(); t++) {
+        const unsigned int at = insertAt[tripletRows[t]]++;
+        unsortedColumns[at] = tripletColumns[t];
+        unsortedValues[at] = tripletValues[t];
+    }
+
+    // Sort each row by column and merge duplicates
+    columns.reserve(tripletRows.size());
+    values.reserve(tripletRows.size());
+    std::vector<unsigned int> rowOrder;
+    unsigned int rowBegin = 0;
+    for (unsigned int row = 0; row < size; row++) {
+        rowOrder.resize(rowOffsets[row + 1] - rowOffsets[row]);
+        for (unsigned int i = 0; i < rowOrder.size(); i++) {
+            rowOrder[i] = rowOffsets[row] + i;
+        }
+        std::sort(rowOrder.begin(), rowOrder.end(), [&](const unsigned int a, const unsigned int b) {
+            return unsortedColumns[a] < unsortedColumns[b];
+        });
+
+        for (const unsigned int entry : rowOrder) {
+            if (columns.size() > rowBegin && columns.back() == unsortedColumns[entry]) {
+                values.back() += unsortedValues[entry];
+            } else {
+                columns.push_back(unsortedColumns[entry]);
+                values.push_back(unsortedValues[entry]);
+            }
+        }
+
+        rowOffsets[row] = rowBegin;
+        rowBegin = columns.size();
+    }
+    rowOffsets[size] = rowBegin;
+}
+
+unsigned int SparseMatrix::nonZeros() const {
+    return columns.size();
+}
+
+double SparseMatrix::at(const unsigned int row, const unsigned int column) const {
+    const auto begin = columns.begin() + rowOffsets[row];
+    const auto end = columns.begin() + rowOffsets[row + 1];
+
+    if (const auto entry = std::lower_bound(begin, end, column);
+        entry != end && *entry == column) {
+        return values[entry - columns.begin()];
+    }
+
+    return 0.0;
+}
+
+void SparseMatrix::multiply(const std::vector<double>& x, std::vector<double>& result) const {
+    result.resize(size);
+
+    for (unsigned int row = 0; row < size; row++) {
+        double sum = 0.0;
+        for (unsigned int entry = rowOffsets[row]; entry < rowOffsets[row + 1]; entry++) {
+            sum += values[entry] * x[columns[entry]];
+        }
+        result[row] = sum;
+    }
+}
+
+void SparseMatrix::residual(
+    const std::vector<double>& rhs,
+    const std::vector<double>& x,
+    std::vector<double>& residual
+) const {
+    multiply(x, residual);
+
+    for (unsigned int row = 0; row < size; row++) {
+        residual[row] = rhs[row] - residual[row];
+    }
+}
+
+SparseMatrix SparseMatrix::transpose() const {
+    SparseMatrix transposed;
+    transposed.size = columnCount;
+    transposed.columnCount = size;
+    transposed.rowOffsets.assign(columnCount + 1, 0);
+    transposed.columns.resize(nonZeros());
+    transposed.values.resize(nonZeros());
+
+    for (const unsigned int column : columns) {
+        transposed.rowOffsets[column + 1]++;
+    }
+    for (unsigned int row = 0; row < columnCount; row++) {
+        transposed.rowOffsets[row + 1] += transposed.rowOffsets[row];
+    }
+
+    // Rows are visited in order, so transposed rows come out sorted by column
+    std::vector<unsigned int> insertAt(transposed.rowOffsets.begin(), transposed.rowOffsets.end() - 1);
+    for (unsigned int row = 0; row < size; row++) {
+        for (unsigned int entry = rowOffsets[row]; entry < rowOffsets[row + 1]; entry++) {
+            const unsigned int at = insertAt[columns[entry]]++;
+            transposed.columns[at] = row;
+            transposed.values[at] = values[entry];
+        }
+    }
+
+    return transposed;
+}
+
+SparseMatrix SparseMatrix::multiply(const SparseMatrix& other) const {
+    SparseMatrix product;
+    product.size = size;
+    product.columnCount = other.columnCount;
+    product.rowOffsets.assign(size + 1, 0);
+
+    // Gustavson's row-by-row product with a dense accumulator
+    // lastRow marks which columns already hold a partial sum for the current row
+    std::vector<double> accumulator(other.columnCount, 0.0);
+    std::vector<unsigned int> lastRow(other.columnCount, size);
+    std::vector<unsigned int> rowColumns;
+
+    for (unsigned int row = 0; row < size; row++) {
+        rowColumns.clear();
+
+        for (unsigned int entry = rowOffsets[row]; entry < rowOffsets[row + 1]; entry++) {
+            const unsigned int k = columns[entry];
+
+            for (unsigned int otherEntry = other.rowOffsets[k]; otherEntry < other.rowOffsets[k + 1]; otherEntry++) {
+                const unsigned int column = other.columns[otherEntry];
+
+                if (lastRow[column] != row) {
+                    lastRow[column] = row;
+                    accumulator[column] = 0.0;
+                    rowColumns.push_back(column);
+                }
+                accumulator[column] += values[entry] * other.values[otherEntry];
+            }
+        }
+
+        std::sort(rowColumns.begin(), rowColumns.end());
+        for (const unsigned int column : rowColumns) {
+            product.columns.push_back(column);
+            product.values.push_back(accumulator[column]);
+        }
+        product.rowOffsets[row + 1] = product.columns.size();
+    }
+
+    return product;
+}
@@ -0,0 +1,55 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <vector>
+
+// Matrix in compressed sparse row (CSR) form, square unless built as size x columnCount
+// Row r holds columns[rowOffsets[r]..rowOffsets[r + 1]) with matching values, sorted by column
+class SparseMatrix {
+public:
+    // Number of rows
+    unsigned int size;
+    unsigned int columnCount;
+    std::vector<unsigned int> rowOffsets;
+    std::vector<unsigned int> columns;
+    std::vector<double> values;
+
+    // Empty 0x0 matrix
+    SparseMatrix();
+
+    // Builds a size x size matrix from (row, column, value) triplets
+    // Triplets may come in any order, duplicates are summed
+    SparseMatrix(
+        unsigned int size,
+        const std::vector<unsigned int>& tripletRows,
+        const std::vector<unsigned int>& tripletColumns,
+        const std::vector<double>& tripletValues
+    );
+
+    // Builds a size x columnCount matrix from (row, column, value) triplets
+    SparseMatrix(
+        unsigned int size,
+        unsigned int columnCount,
+        const std::vector<unsigned int>& tripletRows,
+        const std::vector<unsigned int>& tripletColumns,
+        const std::vector<double>& tripletValues
+    );
+
+    unsigned int nonZeros() const;
+
+    // Returns the stored (row, column) value, or 0 if the entry is not stored
+    double at(unsigned int row, unsigned int column) const;
+
+    // result = this * x
+    void multiply(const std::vector<double>& x, std::vector<double>& result) const;
+
+    // residual = rhs - this * x
+    void residual(const std::vector<double>& rhs, const std::vector<double>& x, std::vector<double>& residual) const;
+
+    SparseMatrix transpose() const;
+
+    // this * other, requires columnCount == other.size
+    SparseMatrix multiply(const SparseMatrix& other) const;
+};
+
+#endif
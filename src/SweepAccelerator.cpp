@@ -0,0 +1,295 @@
+#include "SweepAccelerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Plain sweeps used to estimate the spectral radius, measured over the second half
+#define CHEBYSHEV_ESTIMATION_SWEEPS 16
+// Accelerated sweeps between checks that the iteration keeps up with the estimated rate
+#define CHEBYSHEV_CHECK_SWEEPS 64
+// Restart once the displacement grows this much over the best one seen
+#define CHEBYSHEV_RESTART_GROWTH 8.0
+// Keeps omega away from 2, where the recurrence breaks down
+#define CHEBYSHEV_MAX_SPECTRAL_RADIUS 0.999999
+
+// Clear the history once the residual grows this much over the best one seen
+#define ANDERSON_RESTART_GROWTH 8.0
+// Tikhonov term of the least-squares problem, relative to the largest diagonal entry
+#define ANDERSON_REGULARISATION 1e-10
+#define ANDERSON_DEPTH 5
+
+namespace {
+    // Entry i of a packed vector is u[begin + i] for i < size, v[begin + i - size] after that
+    inline float packed(const unsigned int i, const unsigned int size, const unsigned int begin, const float* u, const float* v) {
+        return i < size ? u[begin + i] : v[begin + i - size];
+    }
+
+    template <typename T>
+    void unpack(const std::vector<T>& x, const unsigned int begin, float* u, float* v) {
+        const unsigned int size = x.size() / 2;
+        for (unsigned int i = 0; i < size; i++) {
+            u[begin + i] = static_cast<float>(x[i]);
+            v[begin + i] = static_cast<float>(x[size + i]);
+        }
+    }
+
+    // Solves the dense n x n system a * x = b in place by Gaussian elimination with partial pivoting
+    // Returns false if a is numerically singular
+    bool solveDense(std::vector<double>& a, std::vector<double>& b, const unsigned int n) {
+        for (unsigned int k = 0; k < n; k++) {
+            unsigned int pivot = k;
+            for (unsigned int r = k + 1; r < n; r++) {
+                if (std::abs(a[r * n + k]) > std::abs(a[pivot * n + k])) {
+                    pivot = r;
+                }
+            }
+            if (!(std::abs(a[pivot * n + k]) > 0.0)) {
+                return false;
+            }
+
+            if (pivot != k) {
+                for (unsigned int c = 0; c < n; c++) {
+                    std::swap(a[k * n + c], a[pivot * n + c]);
+                }
+                std::swap(b[k], b[pivot]);
+            }
+
+            for (unsigned int r = k + 1; r < n; r++) {
+                const double factor = a[r * n + k] / a[k * n + k];
+                for (unsigned int c = k; c < n; c++) {
+                    a[r * n + c] -= factor * a[k * n + c];
+                }
+                b[r] -= factor * b[k];
+            }
+        }
+
+        for (unsigned int k = n; k-- > 0;) {
+            for (unsigned int c = k + 1; c < n; c++) {
+                b[k] -= a[k * n + c] * b[c];
+            }
+            b[k] /= a[k * n + k];
+        }
+
+        return std::isfinite(b[0]);
+    }
+}
+
+ChebyshevAccelerator::ChebyshevAccelerator()
+    : begin(0),
+      end(0),
+      estimationSweepsLeft(CHEBYSHEV_ESTIMATION_SWEEPS),
+      midwayDisplacement(0.0),
+      spectralRadius(0.0),
+      omega(1.0),
+      bestDisplacement(std::numeric_limits<double>::infinity()),
+      checkSweeps(0),
+      checkDisplacement(0.0) {
+}
+
+void ChebyshevAccelerator::start(const unsigned int begin, const unsigned int end, const float* u, const float* v) {
+    this->begin = begin;
+    this->end = end;
+
+    const unsigned int size = end - begin;
+    current.resize(2 * size);
+    for (unsigned int i = 0; i < 2 * size; i++) {
+        current[i] = packed(i, size, begin, u, v);
+    }
+    previous = current;
+
+    estimationSweepsLeft = CHEBYSHEV_ESTIMATION_SWEEPS;
+    spectralRadius = 0.0;
+}
+
+void ChebyshevAccelerator::accelerate(const SweepStatistics& statistics, float* u, float* v) {
+    const unsigned int size = end - begin;
+    const double displacement = std::sqrt(statistics.sumDisplacementSquared);
+
+    if (estimationSweepsLeft == 0) {
+        const double predictedRate = spectralRadius > 0.0
+                                         ? (1.0 - std::sqrt(1.0 - spectralRadius * spectralRadius)) / spectralRadius
+                                         : 0.0;
+
+        // Accelerated sweeps are checked against the rate the estimate promises
+        bool restart = displacement > CHEBYSHEV_RESTART_GROWTH * bestDisplacement;
+        if (++checkSweeps == CHEBYSHEV_CHECK_SWEEPS) {
+            // Falling well behind means some error modes decay slower than the estimate, re-estimate on them
+            const double observedRate = std::pow(displacement / checkDisplacement, 1.0 / CHEBYSHEV_CHECK_SWEEPS);
+            restart = restart || observedRate > std::sqrt(predictedRate);
+            checkSweeps = 0;
+            checkDisplacement = displacement;
+        }
+
+        if (restart) {
+            estimationSweepsLeft = CHEBYSHEV_ESTIMATION_SWEEPS;
+        }
+    }
+
+    if (estimationSweepsLeft > 0) {
+        // Plain sweep: x_{k+1} = sweep(x_k), which u and v already hold
+        estimationSweepsLeft--;
+
+        if (estimationSweepsLeft == CHEBYSHEV_ESTIMATION_SWEEPS / 2) {
+            midwayDisplacement = displacement;
+        } else if (estimationSweepsLeft == 0) {
+            // Displacements of plain sweeps shrink by the spectral radius per sweep, once the fast modes are gone
+            const double estimate = midwayDisplacement > 0.0
+                                        ? std::pow(displacement / midwayDisplacement, 2.0 / CHEBYSHEV_ESTIMATION_SWEEPS)
+                                        : 0.0;
+            // Restarts only ever uncover slower modes, so the estimate never shrinks
+            spectralRadius = std::min(std::max(spectralRadius, estimate), CHEBYSHEV_MAX_SPECTRAL_RADIUS);
+            omega = 1.0;
+            bestDisplacement = displacement;
+            checkSweeps = 0;
+            checkDisplacement = displacement;
+        }
+
+        previous.swap(current);
+        for (unsigned int i = 0; i < 2 * size; i++) {
+            current[i] = packed(i, size, begin, u, v);
+        }
+        return;
+    }
+
+    bestDisplacement = std::min(bestDisplacement, displacement);
+
+    // The plain sweep that ended the estimation counts as the first step, omega_1 = 1
+    const double rhoSquared = spectralRadius * spectralRadius;
+    omega = omega == 1.0 ? 2.0 / (2.0 - rhoSquared) : 1.0 / (1.0 - rhoSquared * omega / 4.0);
+
+    // x_{k+1} = omega (sweep(x_k) - x_{k-1}) + x_{k-1}, written over x_{k-1}
+    for (unsigned int i = 0; i < 2 * size; i++) {
+        const float swept = packed(i, size, begin, u, v);
+        previous[i] = static_cast<float>(omega * (swept - previous[i]) + previous[i]);
+    }
+    previous.swap(current);
+    unpack(current, begin, u, v);
+}
+
+AndersonAccelerator::AndersonAccelerator(const unsigned int depth)
+    : depth(depth),
+      begin(0),
+      end(0),
+      residualDifferences(depth),
+      sweepDifferences(depth),
+      history(0),
+      newest(0),
+      gram(depth * depth, 0.0),
+      bestResidual(std::numeric_limits<double>::infinity()) {
+}
+
+void AndersonAccelerator::clearHistory() {
+    history = 0;
+    newest = depth - 1;
+    bestResidual = std::numeric_limits<double>::infinity();
+}
+
+void AndersonAccelerator::start(const unsigned int begin, const unsigned int end, const float* u, const float* v) {
+    this->begin = begin;
+    this->end = end;
+
+    const unsigned int size = end - begin;
+    current.resize(2 * size);
+    for (unsigned int i = 0; i < 2 * size; i++) {
+        current[i] = packed(i, size, begin, u, v);
+    }
+    previousResidual.clear();
+    previousSweep.clear();
+
+    clearHistory();
+}
+
+void AndersonAccelerator::accelerate(const SweepStatistics& statistics, float* u, float* v) {
+    const unsigned int size = end - begin;
+    const double residualNorm = std::sqrt(statistics.sumDisplacementSquared);
+
+    if (residualNorm > ANDERSON_RESTART_GROWTH * bestResidual) {
+        clearHistory();
+    }
+    bestResidual = std::min(bestResidual, residualNorm);
+
+    // Stores f_k and sweep(x_k), and their differences to the previous ones in the next ring slot
+    const bool hasPrevious = !previousResidual.empty();
+    previousResidual.resize(2 * size);
+    previousSweep.resize(2 * size);
+
+    if (hasPrevious) {
+        newest = (newest + 1) % depth;
+        history = std::min(history + 1, depth);
+        residualDifferences[newest].resize(2 * size);
+        sweepDifferences[newest].resize(2 * size);
+    }
+
+    for (unsigned int i = 0; i < 2 * size; i++) {
+        const double swept = packed(i, size, begin, u, v);
+        const double residual = swept - current[i];
+
+        if (hasPrevious) {
+            residualDifferences[newest][i] = residual - previousResidual[i];
+            sweepDifferences[newest][i] = swept - previousSweep[i];
+        }
+        previousResidual[i] = residual;
+        previousSweep[i] = swept;
+    }
+
+    if (history == 0) {
+        current = previousSweep;
+        return;
+    }
+
+    // Only the newest difference is new, so one row and column of the Gram matrix change
+    for (unsigned int j = 0; j < history; j++) {
+        double dot = 0.0;
+        for (unsigned int i = 0; i < 2 * size; i++) {
+            dot += residualDifferences[newest][i] * residualDifferences[j][i];
+        }
+        gram[newest * depth + j] = dot;
+        gram[j * depth + newest] = dot;
+    }
+
+    // Normal equations of min ||f_k - dF gamma||, lightly regularised against collinear differences
+    std::vector<double> system(history * history);
+    std::vector<double> gamma(history, 0.0);
+    double largestDiagonal = 0.0;
+    for (unsigned int r = 0; r < history; r++) {
+        largestDiagonal = std::max(largestDiagonal, gram[r * depth + r]);
+        for (unsigned int c = 0; c < history; c++) {
+            system[r * history + c] = gram[r * depth + c];
+        }
+        for (unsigned int i = 0; i < 2 * size; i++) {
+            gamma[r] += residualDifferences[r][i] * previousResidual[i];
+        }
+    }
+    for (unsigned int r = 0; r < history; r++) {
+        system[r * history + r] += ANDERSON_REGULARISATION * largestDiagonal;
+    }
+
+    if (!solveDense(system, gamma, history)) {
+        // Take the plain sweep and start collecting differences afresh
+        clearHistory();
+        current = previousSweep;
+        return;
+    }
+
+    // x_{k+1} = sweep(x_k) - dG gamma
+    for (unsigned int i = 0; i < 2 * size; i++) {
+        double mixed = previousSweep[i];
+        for (unsigned int j = 0; j < history; j++) {
+            mixed -= gamma[j] * sweepDifferences[j][i];
+        }
+        current[i] = mixed;
+    }
+    unpack(current, begin, u, v);
+}
+
+std::unique_ptr<SweepAccelerator> makeSweepAccelerator(const AccelerationMode mode) {
+    switch (mode) {
+        case AccelerationMode::Chebyshev:
+            return std::make_unique<ChebyshevAccelerator>();
+        case AccelerationMode::Anderson:
+            return std::make_unique<AndersonAccelerator>(ANDERSON_DEPTH);
+        default:
+            return nullptr;
+    }
+}
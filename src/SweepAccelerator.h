@@ -0,0 +1,87 @@
+#ifndef SWEEP_ACCELERATOR_H
+#define SWEEP_ACCELERATOR_H
+
+#include <memory>
+#include <vector>
+
+#include "RelaxationKernels.h"
+#include "UnwrapParameters.h"
+
+// Extrapolates the fixed-point iteration x_{k+1} = sweep(x_k) over the UVs of vertices [begin, end)
+// Any relaxation sweep that is a fixed linear map can be wrapped, no matrix is needed
+class SweepAccelerator {
+public:
+    virtual ~SweepAccelerator() = default;
+
+    // Records the initial iterate x_0, before the first sweep
+    virtual void start(unsigned int begin, unsigned int end, const float* u, const float* v) = 0;
+
+    // u and v hold sweep(x_k) on entry and the accelerated x_{k+1} on return
+    // statistics measures sweep(x_k) - x_k, the residual of the fixed point at x_k
+    virtual void accelerate(const SweepStatistics& statistics, float* u, float* v) = 0;
+};
+
+// Chebyshev semi-iteration: x_{k+1} = omega_{k+1} (sweep(x_k) - x_{k-1}) + x_{k-1}
+// The spectral radius of the sweep is estimated from how fast plain sweeps shrink the displacement,
+// and re-estimated whenever the accelerated iteration stops making progress
+class ChebyshevAccelerator : public SweepAccelerator {
+    unsigned int begin;
+    unsigned int end;
+    // x_k and x_{k-1}, u followed by v
+    std::vector<float> current;
+    std::vector<float> previous;
+    // Plain sweeps left before the spectral radius is estimated, 0 once accelerating
+    unsigned int estimationSweepsLeft;
+    // Displacement norm midway through the estimation sweeps
+    double midwayDisplacement;
+    double spectralRadius;
+    double omega;
+    // Smallest displacement seen since acceleration (re)started
+    double bestDisplacement;
+    // Accelerated sweeps since the last rate check, and the displacement at that check
+    unsigned int checkSweeps;
+    double checkDisplacement;
+
+public:
+    ChebyshevAccelerator();
+
+    void start(unsigned int begin, unsigned int end, const float* u, const float* v) override;
+
+    void accelerate(const SweepStatistics& statistics, float* u, float* v) override;
+};
+
+// Anderson mixing: x_{k+1} = sweep(x_k) - dG gamma, where gamma minimises ||f_k - dF gamma||
+// f_k = sweep(x_k) - x_k, and dF, dG hold the differences of the last depth residuals and sweeps
+class AndersonAccelerator : public SweepAccelerator {
+    const unsigned int depth;
+    unsigned int begin;
+    unsigned int end;
+    // x_k, f_{k-1} and sweep(x_{k-1}), u followed by v
+    // Kept in double: late residuals sit close to float rounding of the UVs, and the mixing amplifies it
+    std::vector<double> current;
+    std::vector<double> previousResidual;
+    std::vector<double> previousSweep;
+    // Ring buffers of the last depth differences, history entries are valid
+    std::vector<std::vector<double>> residualDifferences;
+    std::vector<std::vector<double>> sweepDifferences;
+    unsigned int history;
+    unsigned int newest;
+    // gram[i * depth + j] = dF_i . dF_j
+    std::vector<double> gram;
+    // Smallest residual norm seen since the history was last cleared
+    double bestResidual;
+
+    void clearHistory();
+
+public:
+    explicit AndersonAccelerator(unsigned int depth);
+
+    void start(unsigned int begin, unsigned int end, const float* u, const float* v) override;
+
+    void accelerate(const SweepStatistics& statistics, float* u, float* v) override;
+};
+
+// Returns the accelerator matching mode, nullptr for AccelerationMode::None
+std::unique_ptr<SweepAccelerator> makeSweepAccelerator(AccelerationMode mode);
+
+#endif
@@ -1,27 +1,123 @@
 #include "TriangleMesh.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <numeric>
+#include <queue>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "BucketQueue.h"
+#include "AtlasPacker.h"
 #include "Cartesian3.h"
-
-#define MAXIMUM_LINE_LENGTH 1024
-
-#define N_ITERATIONS 100000
+#include "LinearSolver.h"
+#include "MappedFile.h"
+#include "ObjParser.h"
+#include "Ordering.h"
+#include "Parallel.h"
+#include "RelaxationKernels.h"
+#include "SweepAccelerator.h"
+#include "UnionFind.h"
+#include "UnwrapMonitor.h"
+#include "UvSnapshotBuffer.h"
+
+// Interior vertices per tile of the blocked relaxation, their UVs and rows fit in a typical L2 cache
+#define RELAXATION_TILE_VERTICES 8192
+// Sweeps run over a tile before moving on to the next one
+#define RELAXATION_TILE_SWEEPS 4
+
+// Rows a worklist thread takes from a queue at once
+#define WORKLIST_BATCH 64
+
+// Sweeps between re-estimates of the over-relaxation factor, the rate is measured over the second half
+#define SOR_ADAPT_SWEEPS 32
+// Keeps the over-relaxation factor away from 2, where the sweep stops converging
+#define SOR_MAX_OMEGA 1.99
+// Below this displacement float rounding distorts the observed rate too much to estimate from
+#define SOR_ESTIMATE_FLOOR (100.0f * std::numeric_limits<float>::epsilon())
+// How far above omega - 1 the rate must be, relative to 2 - omega, for Young's relation to be trusted
+#define SOR_ESTIMATE_GAP 0.1
+
+// PrecisionMode::Mixed hands over from float sweeps to double refinement at this displacement,
+// a few float ulps of the UVs, below which sweeps mostly shuffle round-off
+#define MIXED_PRECISION_HANDOFF (32.0f * std::numeric_limits<float>::epsilon())
+// Every refinement step relaxes the correction until its sweeps move less than this fraction of the residual
+#define REFINEMENT_REDUCTION 0.01
+// Refinement stops once a step shrinks the residual by less than this factor
+#define REFINEMENT_MIN_GAIN 0.5
+
+// Approximate number of vertex updates timed per kernel by benchmarkRelaxation
+#define BENCHMARK_VERTEX_UPDATES 100000000u
 
 #define PREVIOUS_EDGE(x) ((x) % 3) ? ((x) - 1) : ((x) + 2)
 #define NEXT_EDGE(x) (((x) % 3) == 2) ? ((x) - 2) : ((x) + 1)
 
 constexpr unsigned int NO_SUCH_ELEMENT = std::numeric_limits<unsigned int>::max();
 
+namespace {
+    // Atomically adds increment to value and returns the sum
+    float atomicAdd(std::atomic<float>& value, const float increment) {
+        float expected = value.load(std::memory_order_relaxed);
+        while (!value.compare_exchange_weak(expected, expected + increment, std::memory_order_acq_rel)) {
+        }
+        return expected + increment;
+    }
+
+    // Where the progress messages of a stage go: std::cout, or nowhere when it runs quietly
+    std::ostream& logStream(const bool verbose) {
+        thread_local std::ostream discarded(nullptr);
+        return verbose ? std::cout : discarded;
+    }
+
+    // Appends the buffer of every chunk to target in order, copying each one on a thread of its own
+    // An empty target takes the first buffer over instead, so a text parsed as a single chunk is never copied
+    template <typename T>
+    void mergeObjChunks(std::vector<ObjChunk>& chunks, std::vector<T> ObjChunk::* const buffer,
+                        std::vector<T>& target) {
+        std::vector<size_t> offsets(chunks.size() + 1, target.size());
+        for (size_t c = 0; c < chunks.size(); c++) {
+            offsets[c + 1] = offsets[c] + (chunks[c].*buffer).size();
+        }
+
+        const bool takeFirst = target.empty();
+        if (takeFirst) {
+            target = std::move(chunks[0].*buffer);
+        }
+        target.resize(offsets.back());
+
+        runOnThreads(chunks.size(), [&](const unsigned int c) {
+            if (c > 0 || !takeFirst) {
+                std::vector<T>& chunkBuffer = chunks[c].*buffer;
+                std::copy(chunkBuffer.begin(), chunkBuffer.end(), target.begin() + offsets[c]);
+                std::vector<T>().swap(chunkBuffer);
+            }
+        });
+    }
+
+    // Returns attribute with entry v taken from attribute[order[v]]
+    template <typename T>
+    std::vector<T> permuted(const std::vector<T>& attribute, const std::vector<VertexId>& order) {
+        std::vector<T> relabelled(order.size());
+        for (VertexId v = 0; v < order.size(); v++) {
+            relabelled[v] = attribute[order[v]];
+        }
+        return relabelled;
+    }
+}
+
 TriangleMesh::TriangleMesh()
     : centreOfGravity(0.0f, 0.0f, 0.0f),
-      objectSize(0.0f) {
+      objectSize(0.0f),
+      outerLoop(NO_SUCH_ELEMENT) {
     vertices.clear();
     colours.clear();
     normals.clear();
@@ -29,9 +125,15 @@ TriangleMesh::TriangleMesh()
     firstDirectedEdge.clear();
     faceVertices.clear();
     otherHalf.clear();
-    boundary.clear();
+    faceGroups.clear();
+    chartOffsets.clear();
+    edgeFlags.clear();
+    vertexFlags.clear();
+    faceFlags.clear();
+    boundaryLoopOffsets.clear();
+    boundaryLoopEdges.clear();
+    boundaryLoopPerimeters.clear();
     boundaryVertices.clear();
-    boundaryVerticesLookup.clear();
 }
 
 void TriangleMesh::computeCentreOfGravity() {
@@ -63,50 +165,87 @@ void TriangleMesh::computeCentreOfGravity() {
     }
 }
 
+bool TriangleMesh::readFromObjFile(const std::string& path) {
+    const MappedFile file(path);
+    if (!file.isOpen()) {
+        return false;
+    }
+
+    return readFromObjText(file.begin(), file.end());
+}
+
 bool TriangleMesh::readFromObjFile(std::istream& objFile) {
-    while (!objFile.eof()) {
-        std::string token;
-        objFile >> token;
-
-        // Switch on the string token
-        if (token == "#") {
-            // Comment line, consume
-            objFile.ignore(MAXIMUM_LINE_LENGTH, '\n');
-        } else if (token == "v") {
-            // Vertex read
-            Cartesian3 vertex;
-            objFile >> vertex;
-            vertices.push_back(vertex);
-        } else if (token == "vc") {
-            // Colour read
-            Cartesian3 colour;
-            objFile >> colour;
-            colours.push_back(colour);
-        } else if (token == "vn") {
-            // Normal read
-            Cartesian3 normal;
-            objFile >> normal;
-            normals.push_back(normal);
-        } else if (token == "vt") {
-            // Texture coordinate read
-            Cartesian3 texCoord;
-            objFile >> texCoord;
-            textureCoords.push_back(texCoord);
-        } else if (token == "f") {
-            // Face data, assume a single triangle per line
-            unsigned int vertexId;
-            for (unsigned int v = 0; v < 3; v++) {
-                objFile >> vertexId;
-                faceVertices.push_back(vertexId - 1);
-            }
+    const std::string text((std::istreambuf_iterator<char>(objFile)), std::istreambuf_iterator<char>());
+    return readFromObjText(text.data(), text.data() + text.size());
+}
+
+bool TriangleMesh::readFromObjText(const char* const begin, const char* const end) {
+    // Parse runs of whole lines on every thread, each into buffers of its own
+    const size_t chunkCount = std::min<size_t>(hardwareThreads(), (end - begin) / OBJ_CHUNK_BYTES + 1);
+    const std::vector<const char*> bounds = splitObjText(begin, end, chunkCount);
+    std::vector<ObjChunk> chunks(chunkCount);
+    runOnThreads(chunkCount, [&](const unsigned int c) {
+        chunks[c].parse(bounds[c], bounds[c + 1]);
+    });
+
+    // Groups are numbered in order of appearance, faces before the first one are in group 0
+    // chunkGroups[c][g] is the number of group g of chunk c, 0 being the one in effect where it starts
+    std::unordered_map<std::string, unsigned int> groupIds{{"", 0}};
+    std::vector<std::vector<unsigned int>> chunkGroups(chunkCount);
+    unsigned int group = 0;
+    for (size_t c = 0; c < chunkCount; c++) {
+        chunkGroups[c].push_back(group);
+        for (const std::string& name : chunks[c].groupNames) {
+            group = groupIds.emplace(name, groupIds.size()).first->second;
+            chunkGroups[c].push_back(group);
+        }
+    }
+
+    // Where every chunk's vertices will start, which resolves its relative corners
+    std::vector<size_t> vertexOffsets(chunkCount + 1, vertices.size());
+    for (size_t c = 0; c < chunkCount; c++) {
+        vertexOffsets[c + 1] = vertexOffsets[c] + chunks[c].vertices.size();
+    }
+
+    const size_t vertexCount = vertexOffsets[chunkCount];
+    for (size_t c = 0; c < chunkCount; c++) {
+        if (chunks[c].oversizedIndex) {
+            std::cerr << "Face refers to a vertex past the largest vertex id" << std::endl;
+            return false;
+        }
+        if (chunks[c].largestVertex >= static_cast<long long>(vertexCount)) {
+            std::cerr << "Face refers to vertex " << chunks[c].largestVertex + 1 << " of " << vertexCount << std::endl;
+            return false;
+        }
+        if (chunks[c].zeroIndex || static_cast<long long>(vertexOffsets[c]) + chunks[c].smallestRelativeVertex < 0) {
+            std::cerr << "Face refers to a vertex before the first one" << std::endl;
+            return false;
         }
     }
 
+    runOnThreads(chunkCount, [&](const unsigned int c) {
+        ObjChunk& chunk = chunks[c];
+        for (const size_t corner : chunk.relativeCorners) {
+            chunk.faceVertices[corner] += static_cast<unsigned int>(vertexOffsets[c]);
+        }
+        for (unsigned int& g : chunk.faceGroups) {
+            g = chunkGroups[c][g];
+        }
+    });
+
+    mergeObjChunks(chunks, &ObjChunk::vertices, vertices);
+    mergeObjChunks(chunks, &ObjChunk::colours, colours);
+    mergeObjChunks(chunks, &ObjChunk::normals, normals);
+    mergeObjChunks(chunks, &ObjChunk::textureCoords, textureCoords);
+    mergeObjChunks(chunks, &ObjChunk::faceVertices, faceVertices);
+    mergeObjChunks(chunks, &ObjChunk::faceGroups, faceGroups);
+
     centreOfGravity = Cartesian3(0.0, 0.0, 0.0);
 
     computeCentreOfGravity();
     computeHalfEdge();
     computeNormals();
+    cutToDisk(std::cout);
     computeBoundary();
 
     return true;
@@ -117,69 +256,566 @@ void TriangleMesh::computeHalfEdge() {
     firstDirectedEdge.assign(vertices.size(), NO_SUCH_ELEMENT);
     otherHalf.assign(faceVertices.size(), NO_SUCH_ELEMENT);
 
-    // Compute otherHalf & firstDirectedEdge
-    for (unsigned int edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
-        const EdgeId from = faceVertices[PREVIOUS_EDGE(edgeId)];
-        const EdgeId to = faceVertices[edgeId];
+    // Bucket directed edges by their origin vertex (counting sort, stable in edgeId)
+    // outgoingOffsets[v]..outgoingOffsets[v + 1] delimits the edges leaving v in outgoingEdges
+    std::vector<EdgeId> outgoingOffsets(vertices.size() + 1, 0);
+    for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+        outgoingOffsets[faceVertices[PREVIOUS_EDGE(edgeId)] + 1]++;
+    }
+    for (VertexId v = 0; v < vertices.size(); v++) {
+        outgoingOffsets[v + 1] += outgoingOffsets[v];
+    }
+
+    std::vector<EdgeId> outgoingEdges(faceVertices.size());
+    std::vector<EdgeId> insertAt(outgoingOffsets.begin(), outgoingOffsets.end() - 1);
+    for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+        outgoingEdges[insertAt[faceVertices[PREVIOUS_EDGE(edgeId)]]++] = edgeId;
+    }
 
-        // Assign FDE if not present
-        if (firstDirectedEdge[from] == NO_SUCH_ELEMENT) {
-            firstDirectedEdge[from] = edgeId;
+    // FDE is the lowest edgeId leaving each vertex, which is the head of its bucket
+    for (VertexId v = 0; v < vertices.size(); v++) {
+        if (outgoingOffsets[v] != outgoingOffsets[v + 1]) {
+            firstDirectedEdge[v] = outgoingEdges[outgoingOffsets[v]];
         }
+    }
 
-        // Linear search for other half
-        for (unsigned int otherEdgeId = 0; otherEdgeId < faceVertices.size(); otherEdgeId++) {
-            const EdgeId otherFrom = faceVertices[PREVIOUS_EDGE(otherEdgeId)];
-            const EdgeId otherTo = faceVertices[otherEdgeId];
-
-            // Fails silently on non-manifold meshes
-            if (from == otherTo && to == otherFrom) {
+    // The other half of from -> to is an edge leaving `to` that points back at `from`
+    // On non-manifold meshes, the lowest matching edgeId is the candidate
+    const auto lowestReverseEdge = [&](const EdgeId edgeId) {
+        const VertexId from = faceVertices[PREVIOUS_EDGE(edgeId)];
+        const VertexId to = faceVertices[edgeId];
+        for (EdgeId o = outgoingOffsets[to]; o < outgoingOffsets[to + 1]; o++) {
+            if (const EdgeId otherEdgeId = outgoingEdges[o];
+                faceVertices[otherEdgeId] == from) {
+                return otherEdgeId;
+            }
+        }
+        return NO_SUCH_ELEMENT;
+    };
+
+    // Edges are only paired when each is the other's candidate, so otherHalf stays an involution
+    // Each edge only writes its own slot, so edges are paired in parallel
+    parallelFor(0, faceVertices.size(), [&](const EdgeId begin, const EdgeId end) {
+        for (EdgeId edgeId = begin; edgeId < end; edgeId++) {
+            const EdgeId otherEdgeId = lowestReverseEdge(edgeId);
+            if (otherEdgeId != NO_SUCH_ELEMENT && lowestReverseEdge(otherEdgeId) == edgeId) {
                 otherHalf[edgeId] = otherEdgeId;
-                otherHalf[otherEdgeId] = edgeId;
-                break;
             }
         }
-    }
+    });
 }
 
 void TriangleMesh::computeBoundary() {
     // Reset boundary
-    boundary.clear();
     boundaryVertices.clear();
-    boundaryVerticesLookup.clear();
+    edgeFlags.assign(faceVertices.size(), 0);
+    vertexFlags.assign(vertices.size(), 0);
+    faceFlags.assign(faceVertices.size() / 3, 0);
+
+    computeBoundaryLoops();
+
+    // Every loop is boundary, but only the outer one is pinned: the holes are filled for Floater's
+    for (const EdgeId edgeId : boundaryLoopEdges) {
+        edgeFlags[edgeId] |= BOUNDARY_FLAG;
+        vertexFlags[faceVertices[edgeId]] |= BOUNDARY_FLAG;
+        faceFlags[edgeId / 3] |= BOUNDARY_FLAG;
+    }
+    if (outerLoop != NO_SUCH_ELEMENT) {
+        for (EdgeId e = boundaryLoopOffsets[outerLoop]; e < boundaryLoopOffsets[outerLoop + 1]; e++) {
+            boundaryVertices.push_back(faceVertices[boundaryLoopEdges[e]]);
+            vertexFlags[faceVertices[boundaryLoopEdges[e]]] |= PINNED_FLAG;
+        }
+    }
+}
+
+void TriangleMesh::computeBoundaryLoops() {
+    boundaryLoopOffsets.assign(1, 0);
+    boundaryLoopEdges.clear();
+    boundaryLoopPerimeters.clear();
+    outerLoop = NO_SUCH_ELEMENT;
+
+    // Single pass over the edges, every boundary edge is walked exactly once
+    std::vector<bool> visited(faceVertices.size(), false);
+    for (EdgeId firstEdge = 0; firstEdge < faceVertices.size(); firstEdge++) {
+        if (otherHalf[firstEdge] != NO_SUCH_ELEMENT || visited[firstEdge]) {
+            continue;
+        }
+
+        float perimeter = 0.0f;
+        EdgeId boundaryEdge = firstEdge;
+        do {
+            visited[boundaryEdge] = true;
+            boundaryLoopEdges.push_back(boundaryEdge);
+            const Cartesian3& from = vertices[faceVertices[PREVIOUS_EDGE(boundaryEdge)]];
+            perimeter += (vertices[faceVertices[boundaryEdge]] - from).length();
+
+            // Go around the neighbourhood until I hit the boundary
+            while (otherHalf[NEXT_EDGE(boundaryEdge)] != NO_SUCH_ELEMENT) {
+                boundaryEdge = otherHalf[NEXT_EDGE(boundaryEdge)];
+            }
+
+            // Move to next boundary neighbourhood
+            boundaryEdge = NEXT_EDGE(boundaryEdge);
+            // The visited check stops the walk on non-manifold boundaries, which may not lead back
+        } while (boundaryEdge != firstEdge && !visited[boundaryEdge]);
+
+        if (outerLoop == NO_SUCH_ELEMENT || perimeter > boundaryLoopPerimeters[outerLoop]) {
+            outerLoop = boundaryLoopPerimeters.size();
+        }
+        boundaryLoopOffsets.push_back(boundaryLoopEdges.size());
+        boundaryLoopPerimeters.push_back(perimeter);
+    }
+}
+
+void TriangleMesh::fillHoles() {
+    const unsigned int loopCount = boundaryLoopPerimeters.size();
+    const bool fillColours = colours.size() == vertices.size();
+    const bool fillNormals = normals.size() == vertices.size();
+    const bool fillTextureCoords = textureCoords.size() == vertices.size();
+
+    for (unsigned int loop = 0; loop < loopCount; loop++) {
+        if (loop == outerLoop) {
+            continue;
+        }
+
+        const EdgeId begin = boundaryLoopOffsets[loop];
+        const EdgeId end = boundaryLoopOffsets[loop + 1];
+
+        Cartesian3 centre(0.0f, 0.0f, 0.0f);
+        for (EdgeId e = begin; e < end; e++) {
+            centre = centre + vertices[faceVertices[boundaryLoopEdges[e]]];
+        }
+        const VertexId centreVertex = vertices.size();
+        vertices.push_back(centre / (end - begin));
+        vertexFlags.push_back(0);
+        if (fillColours) {
+            colours.push_back(Cartesian3(0.0f, 0.0f, 0.0f));
+        }
+        if (fillNormals) {
+            normals.push_back(Cartesian3(0.0f, 0.0f, 0.0f));
+        }
+        if (fillTextureCoords) {
+            textureCoords.push_back(Cartesian3(0.0f, 0.0f, 0.0f));
+        }
+
+        // One triangle per edge, running against the boundary edge so that the two become other halves
+        for (EdgeId e = begin; e < end; e++) {
+            const EdgeId boundaryEdge = boundaryLoopEdges[e];
+            faceVertices.push_back(faceVertices[boundaryEdge]);
+            faceVertices.push_back(faceVertices[PREVIOUS_EDGE(boundaryEdge)]);
+            faceVertices.push_back(centreVertex);
+        }
+    }
 
-    // Find first boundary edge
-    // Hard assumptions: It always exists and it's unique
-    long firstBoundaryEdge = NO_SUCH_ELEMENT;
-    for (unsigned int edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+    edgeFlags.resize(faceVertices.size(), 0);
+    faceFlags.resize(faceVertices.size() / 3, 0);
+}
+
+void TriangleMesh::cutToDisk(std::ostream& log) {
+    if (faceVertices.empty()) {
+        return;
+    }
+
+    computeBoundaryLoops();
+    const unsigned int loopCount = boundaryLoopPerimeters.size();
+    const long faceCount = faceVertices.size() / 3;
+
+    // Undirected edges are named by their lower half, or their only half on the boundary
+    const auto undirected = [&](const EdgeId edgeId) {
+        return otherHalf[edgeId] != NO_SUCH_ELEMENT && otherHalf[edgeId] < edgeId ? otherHalf[edgeId] : edgeId;
+    };
+    const auto fromVertex = [&](const EdgeId edgeId) {
+        return faceVertices[PREVIOUS_EDGE(edgeId)];
+    };
+    const auto edgeLength = [&](const EdgeId edgeId) {
+        return (vertices[faceVertices[edgeId]] - vertices[fromVertex(edgeId)]).length();
+    };
+
+    // Edges around each vertex, boundary edges are listed at both ends as they have no other half
+    std::vector<EdgeId> incidentOffsets(vertices.size() + 1, 0);
+    for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+        incidentOffsets[fromVertex(edgeId) + 1]++;
         if (otherHalf[edgeId] == NO_SUCH_ELEMENT) {
-            firstBoundaryEdge = edgeId;
+            incidentOffsets[faceVertices[edgeId] + 1]++;
+        }
+    }
+    for (VertexId v = 0; v < vertices.size(); v++) {
+        incidentOffsets[v + 1] += incidentOffsets[v];
+    }
+    std::vector<EdgeId> incidentEdges(incidentOffsets.back());
+    std::vector<EdgeId> insertAt(incidentOffsets.begin(), incidentOffsets.end() - 1);
+    for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+        incidentEdges[insertAt[fromVertex(edgeId)]++] = edgeId;
+        if (otherHalf[edgeId] == NO_SUCH_ELEMENT) {
+            incidentEdges[insertAt[faceVertices[edgeId]]++] = edgeId;
+        }
+    }
+
+    // Genus from the Euler characteristic V - E + F = 2 - 2g - loops, which only holds component by component
+    // A vertex shared by several components counts once in each
+    std::vector<unsigned int> faceComponents;
+    const unsigned int componentCount = labelCharts(ChartMode::Components, faceComponents);
+    const auto componentOf = [&](const EdgeId edgeId) {
+        return faceComponents[edgeId / 3];
+    };
+
+    std::vector<long> eulerCharacteristic(componentCount, 0);
+    std::vector<VertexId> countedAt(componentCount, NO_SUCH_ELEMENT);
+    for (VertexId v = 0; v < vertices.size(); v++) {
+        for (EdgeId i = incidentOffsets[v]; i < incidentOffsets[v + 1]; i++) {
+            const unsigned int component = componentOf(incidentEdges[i]);
+            if (countedAt[component] != v) {
+                countedAt[component] = v;
+                eulerCharacteristic[component]++;
+            }
+        }
+    }
+    for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+        eulerCharacteristic[componentOf(edgeId)] -= undirected(edgeId) == edgeId;
+    }
+    for (FaceIndex face = 0; face < faceCount; face++) {
+        eulerCharacteristic[faceComponents[face]]++;
+    }
+
+    // Every component is cut from its longest boundary loop, which stays the outline of its disk
+    // Closed components start from a single vertex instead
+    std::vector<unsigned int> componentLoops(componentCount, 0);
+    std::vector<unsigned int> rootLoops(componentCount, NO_SUCH_ELEMENT);
+    for (unsigned int l = 0; l < loopCount; l++) {
+        const unsigned int component = componentOf(boundaryLoopEdges[boundaryLoopOffsets[l]]);
+        componentLoops[component]++;
+        if (rootLoops[component] == NO_SUCH_ELEMENT
+            || boundaryLoopPerimeters[l] > boundaryLoopPerimeters[rootLoops[component]]) {
+            rootLoops[component] = l;
+        }
+    }
+
+    // Disks, with or without extra holes, need no cut
+    std::vector<bool> cutComponent(componentCount, false);
+    unsigned int cutComponents = 0;
+    long cutGenus = 0;
+    unsigned int cutLoops = 0;
+    for (unsigned int component = 0; component < componentCount; component++) {
+        const long genus = (2 - static_cast<long>(componentLoops[component]) - eulerCharacteristic[component]) / 2;
+        if (componentLoops[component] == 0 || genus > 0) {
+            cutComponent[component] = true;
+            cutComponents++;
+            cutGenus += genus;
+            cutLoops += componentLoops[component];
+        }
+    }
+    if (cutComponents == 0) {
+        return;
+    }
+
+    log << "Cutting seams in " << cutComponents << " of " << componentCount << " components: genus " << cutGenus
+        << ", " << cutLoops << " boundary loops..." << std::endl;
+
+    std::vector<VertexId> rootVertices(componentCount, NO_SUCH_ELEMENT);
+    for (FaceIndex face = faceCount; face-- > 0; ) {
+        rootVertices[faceComponents[face]] = fromVertex(3 * face);
+    }
+
+    // Shortest-path forest (Dijkstra) from the roots, treating every root loop as a single source
+    // Components left whole are never entered, they get no seams
+    std::vector<float> distance(vertices.size(), std::numeric_limits<float>::infinity());
+    std::vector<EdgeId> parentEdge(vertices.size(), NO_SUCH_ELEMENT);
+    std::vector<bool> pinned(vertices.size(), false);
+    std::vector<bool> rootEdge(faceVertices.size(), false);
+
+    typedef std::pair<float, VertexId> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    for (unsigned int component = 0; component < componentCount; component++) {
+        if (!cutComponent[component]) {
+            continue;
+        }
+        const unsigned int rootLoop = rootLoops[component];
+        if (rootLoop == NO_SUCH_ELEMENT) {
+            const VertexId root = rootVertices[component];
+            distance[root] = 0.0f;
+            queue.emplace(0.0f, root);
+        } else {
+            for (EdgeId e = boundaryLoopOffsets[rootLoop]; e < boundaryLoopOffsets[rootLoop + 1]; e++) {
+                const EdgeId edgeId = boundaryLoopEdges[e];
+                rootEdge[edgeId] = true;
+                pinned[faceVertices[edgeId]] = true;
+                distance[faceVertices[edgeId]] = 0.0f;
+                queue.emplace(0.0f, faceVertices[edgeId]);
+            }
+        }
+    }
+
+    while (!queue.empty()) {
+        const auto [vertexDistance, v] = queue.top();
+        queue.pop();
+        if (vertexDistance > distance[v]) {
+            continue;
+        }
+
+        for (EdgeId i = incidentOffsets[v]; i < incidentOffsets[v + 1]; i++) {
+            const EdgeId edgeId = incidentEdges[i];
+            if (!cutComponent[componentOf(edgeId)]) {
+                continue;
+            }
+            const VertexId neighbour = fromVertex(edgeId) == v ? faceVertices[edgeId] : fromVertex(edgeId);
+            const float neighbourDistance = vertexDistance + edgeLength(edgeId);
+            if (neighbourDistance < distance[neighbour]) {
+                distance[neighbour] = neighbourDistance;
+                parentEdge[neighbour] = undirected(edgeId);
+                queue.emplace(neighbourDistance, neighbour);
+            }
+        }
+    }
+
+    std::vector<bool> treeEdge(faceVertices.size(), false);
+    for (VertexId v = 0; v < vertices.size(); v++) {
+        if (parentEdge[v] != NO_SUCH_ELEMENT) {
+            treeEdge[parentEdge[v]] = true;
+        }
+    }
+
+    // Dual spanning tree over the faces, plus one cap face closing every other boundary loop, through edges
+    // off the shortest-path tree. Taking the edges with the longest tree loops first leaves out the 2g edges
+    // whose loops (tree path, edge, tree path back) are shortest, which is the greedy shortest system of loops
+    std::vector<unsigned int> capOf(faceVertices.size(), NO_SUCH_ELEMENT);
+    for (unsigned int l = 0; l < loopCount; l++) {
+        for (EdgeId e = boundaryLoopOffsets[l]; e < boundaryLoopOffsets[l + 1]; e++) {
+            capOf[boundaryLoopEdges[e]] = faceCount + l;
+        }
+    }
+
+    std::vector<std::pair<float, EdgeId>> dualCandidates;
+    for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+        if (undirected(edgeId) == edgeId && !treeEdge[edgeId] && !rootEdge[edgeId]
+            && cutComponent[componentOf(edgeId)] && std::isfinite(distance[fromVertex(edgeId)])) {
+            const float loopLength = distance[fromVertex(edgeId)] + distance[faceVertices[edgeId]] + edgeLength(edgeId);
+            dualCandidates.emplace_back(loopLength, edgeId);
+        }
+    }
+    std::sort(dualCandidates.begin(), dualCandidates.end(), std::greater<>());
+
+    std::vector<EdgeId> cutEdges;
+    UnionFind dualComponents(faceCount + loopCount);
+    for (const auto& [loopLength, edgeId] : dualCandidates) {
+        const unsigned int otherFace = otherHalf[edgeId] == NO_SUCH_ELEMENT ? capOf[edgeId] : otherHalf[edgeId] / 3;
+        if (!dualComponents.unite(edgeId / 3, otherFace)) {
+            cutEdges.push_back(edgeId);
+        }
+    }
+    for (VertexId v = 0; v < vertices.size(); v++) {
+        if (parentEdge[v] != NO_SUCH_ELEMENT) {
+            cutEdges.push_back(parentEdge[v]);
+        }
+    }
+
+    // Prune the tree branches leading nowhere, leaving the loops and the paths joining them to the root loop
+    std::vector<unsigned int> cutDegree(vertices.size(), 0);
+    std::vector<EdgeId> cutOffsets(vertices.size() + 1, 0);
+    for (const EdgeId edgeId : cutEdges) {
+        cutOffsets[fromVertex(edgeId) + 1]++;
+        cutOffsets[faceVertices[edgeId] + 1]++;
+    }
+    for (VertexId v = 0; v < vertices.size(); v++) {
+        cutDegree[v] = cutOffsets[v + 1];
+        cutOffsets[v + 1] += cutOffsets[v];
+    }
+    std::vector<unsigned int> vertexCuts(cutOffsets.back());
+    insertAt.assign(cutOffsets.begin(), cutOffsets.end() - 1);
+    for (unsigned int c = 0; c < cutEdges.size(); c++) {
+        vertexCuts[insertAt[fromVertex(cutEdges[c])]++] = c;
+        vertexCuts[insertAt[faceVertices[cutEdges[c]]]++] = c;
+    }
+
+    std::vector<bool> pruned(cutEdges.size(), false);
+    std::vector<VertexId> leaves;
+    for (VertexId v = 0; v < vertices.size(); v++) {
+        if (cutDegree[v] == 1 && !pinned[v]) {
+            leaves.push_back(v);
+        }
+    }
+    while (!leaves.empty()) {
+        const VertexId leaf = leaves.back();
+        leaves.pop_back();
+
+        for (EdgeId i = cutOffsets[leaf]; i < cutOffsets[leaf + 1]; i++) {
+            const unsigned int c = vertexCuts[i];
+            if (pruned[c]) {
+                continue;
+            }
+
+            pruned[c] = true;
+            cutDegree[leaf]--;
+            const VertexId other =
+                fromVertex(cutEdges[c]) == leaf ? faceVertices[cutEdges[c]] : fromVertex(cutEdges[c]);
+            if (--cutDegree[other] == 1 && !pinned[other]) {
+                leaves.push_back(other);
+            }
             break;
         }
     }
 
-    // Loop around boundary
-    long boundaryEdge = firstBoundaryEdge;
-    do {
-        // Store boundary edge
-        boundary.insert(boundaryEdge);
+    std::vector<bool> isCut(faceVertices.size(), false);
+    unsigned int seamEdges = 0;
+    std::vector<unsigned int> componentSeams(componentCount, 0);
+    for (unsigned int c = 0; c < cutEdges.size(); c++) {
+        if (!pruned[c]) {
+            isCut[cutEdges[c]] = true;
+            seamEdges++;
+            componentSeams[componentOf(cutEdges[c])]++;
+        }
+    }
+
+    // A closed sphere prunes away entirely, it is slit open along the tree path to its farthest vertex
+    // The slit needs two edges at least, or it has no inner vertex to split
+    std::vector<VertexId> farthest(componentCount, NO_SUCH_ELEMENT);
+    for (unsigned int component = 0; component < componentCount; component++) {
+        if (cutComponent[component] && rootLoops[component] == NO_SUCH_ELEMENT && componentSeams[component] == 0) {
+            farthest[component] = rootVertices[component];
+        }
+    }
+    for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+        const VertexId v = faceVertices[edgeId];
+        VertexId& slitEnd = farthest[componentOf(edgeId)];
+        if (slitEnd != NO_SUCH_ELEMENT
+            && (distance[v] > distance[slitEnd] || (distance[v] == distance[slitEnd] && v < slitEnd))) {
+            slitEnd = v;
+        }
+    }
+
+    for (unsigned int component = 0; component < componentCount; component++) {
+        if (farthest[component] == NO_SUCH_ELEMENT) {
+            continue;
+        }
+
+        unsigned int slitEdges = 0;
+        for (VertexId v = farthest[component]; parentEdge[v] != NO_SUCH_ELEMENT; ) {
+            isCut[parentEdge[v]] = true;
+            slitEdges++;
+            v = fromVertex(parentEdge[v]) == v ? faceVertices[parentEdge[v]] : fromVertex(parentEdge[v]);
+        }
 
-        // Collect boundary vertex
-        boundaryVertices.push_back(faceVertices[boundaryEdge]);
-        boundaryVerticesLookup.insert(faceVertices[boundaryEdge]);
+        if (slitEdges == 1) {
+            const VertexId root = rootVertices[component];
+            for (EdgeId i = incidentOffsets[farthest[component]]; i < incidentOffsets[farthest[component] + 1]; i++) {
+                const EdgeId edgeId = incidentEdges[i];
+                if (componentOf(edgeId) == component && faceVertices[edgeId] != root && fromVertex(edgeId) != root) {
+                    isCut[undirected(edgeId)] = true;
+                    slitEdges++;
+                    break;
+                }
+            }
+        }
+        seamEdges += slitEdges;
+    }
 
-        // Go around the neighbourhood until I hit the boundary
-        while (otherHalf[NEXT_EDGE(boundaryEdge)] != NO_SUCH_ELEMENT) {
-            boundaryEdge = otherHalf[NEXT_EDGE(boundaryEdge)];
+    std::vector<bool> onSeam(vertices.size(), false);
+    for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+        if (otherHalf[edgeId] != NO_SUCH_ELEMENT && isCut[otherHalf[edgeId]]) {
+            isCut[edgeId] = true;
         }
+        if (isCut[edgeId]) {
+            onSeam[fromVertex(edgeId)] = true;
+        }
+    }
+
+    // Split every vertex on the seam into one copy per wedge of faces between consecutive seam edges
+    // Outgoing edges are walked in fan order, from edgeId to NEXT_EDGE(otherHalf[edgeId]), and crossing edgeId
+    // leaves the wedge if it is cut. The first wedge keeps the original vertex
+    const VertexId originalCount = vertices.size();
+    const bool copyColours = colours.size() == originalCount;
+    const bool copyTextureCoords = textureCoords.size() == originalCount;
+    for (VertexId v = 0; v < originalCount; v++) {
+        const EdgeId first = firstDirectedEdge[v];
+        if (!onSeam[v]) {
+            continue;
+        }
+
+        // Open fans start right after the boundary, closed ones right after a seam edge
+        EdgeId start = first;
+        for (bool cutOnly = false; otherHalf[PREVIOUS_EDGE(start)] != NO_SUCH_ELEMENT; ) {
+            if (cutOnly && isCut[PREVIOUS_EDGE(start)]) {
+                break;
+            }
+            start = otherHalf[PREVIOUS_EDGE(start)];
+            if (start == first) {
+                if (cutOnly) {
+                    // The seam touches another fan of a non-manifold vertex, this one stays whole
+                    break;
+                }
+                cutOnly = true;
+            }
+        }
+
+        VertexId wedgeVertex = v;
+        for (EdgeId edgeId = start; ; ) {
+            faceVertices[PREVIOUS_EDGE(edgeId)] = wedgeVertex;
+            if (otherHalf[edgeId] == NO_SUCH_ELEMENT) {
+                break;
+            }
+            const EdgeId nextEdge = NEXT_EDGE(otherHalf[edgeId]);
+            if (nextEdge == start) {
+                break;
+            }
+
+            if (isCut[edgeId]) {
+                wedgeVertex = vertices.size();
+                vertices.push_back(Cartesian3(vertices[v]));
+                normals.push_back(Cartesian3(normals[v]));
+                if (copyColours) {
+                    colours.push_back(Cartesian3(colours[v]));
+                }
+                if (copyTextureCoords) {
+                    textureCoords.push_back(Cartesian3(textureCoords[v]));
+                }
+            }
+            edgeId = nextEdge;
+        }
+    }
 
-        // Move to next boundary neighbourhood
-        boundaryEdge = NEXT_EDGE(boundaryEdge);
-    } while (boundaryEdge != firstBoundaryEdge);
+    log << "Cut " << seamEdges << " seam edges, duplicating " << vertices.size() - originalCount
+              << " vertices" << std::endl;
+
+    computeHalfEdge();
+}
+
+UnwrapReport TriangleMesh::unwrap(const UnwrapParameters& parameters) {
+    // Times the whole unwrap, the time limit included
+    UnwrapMonitor monitor(parameters);
+
+    std::vector<unsigned int> faceCharts;
+    const unsigned int chartCount = labelCharts(parameters.charts, faceCharts);
+    if (chartCount > 1) {
+        return unwrapCharts(faceCharts, chartCount, parameters, monitor);
+    }
+
+    const UnwrapReport report = unwrapChart(parameters, monitor);
+    chartOffsets = {0, static_cast<VertexId>(vertices.size())};
+    return report;
 }
 
-void TriangleMesh::unwrap() {
-    std::cout << "Relabelling vertices for Floater's..." << std::endl;
+UnwrapReport TriangleMesh::unwrapChart(const UnwrapParameters& parameters, UnwrapMonitor& monitor) {
+    std::ostream& log = logStream(parameters.verbose);
+
+    if (boundaryVertices.empty()) {
+        std::cerr << "No boundary loop to map onto the square, nothing to unwrap" << std::endl;
+        UnwrapReport report;
+        monitor.finish(report);
+        return report;
+    }
+
+    // Holes are filled with a fan around a vertex at their centre, which makes the chart a disk for the solve
+    // The fillings are appended, so they are easy to strip once solved
+    const VertexId meshVertices = vertices.size();
+    const EdgeId meshEdges = faceVertices.size();
+    // Decided here, vertex counts cannot tell later as relabelling also drops unconnected vertices
+    const bool filled = boundaryLoopPerimeters.size() > 1;
+    if (filled) {
+        log << "Filling " << boundaryLoopPerimeters.size() - 1 << " holes" << std::endl;
+        fillHoles();
+        computeHalfEdge();
+    }
+
+    log << "Relabelling vertices for Floater's..." << std::endl;
 
     // Prepare vertices for Floater's
     const std::vector<VertexId> exteriorVertices = boundaryVertices;
@@ -187,50 +823,50 @@ void TriangleMesh::unwrap() {
     for (VertexId v = 0; v < vertices.size(); v++) {
         // Skip non-connected vertices and boundary vertices
         // The latter are already computed in ComputeBoundary()
-        if (firstDirectedEdge[v] == NO_SUCH_ELEMENT || isBoundaryVertex(v)) {
+        if (firstDirectedEdge[v] == NO_SUCH_ELEMENT || isPinnedVertex(v)) {
             continue;
         }
 
         interiorVertices.push_back(v);
     }
 
-    // Re-label vertices
+    // Re-label vertices: boundary first, in loop order, then interior
     const VertexId b = exteriorVertices.size();
     const VertexId n = interiorVertices.size();
-    std::vector<Cartesian3> relabelledVertices(b + n);
-    std::vector<Cartesian3> relaballedColours(b + n);
-    std::vector<EdgeId> relabelledFirstDirectedEdge(b + n);
-    std::unordered_map<VertexId, VertexId> floatersMapping;
-    for (VertexId v = 0; v < relabelledVertices.size(); v++) {
-        VertexId vertexId = v < b ? exteriorVertices[v] : interiorVertices[v - b];
-        floatersMapping[vertexId] = v;
-        relabelledVertices[v] = vertices[vertexId];
-        relaballedColours[v] = colours[vertexId];
-        relabelledFirstDirectedEdge[v] = firstDirectedEdge[vertexId];
-    }
-
-    // Re-label faceVertices
-    std::vector<VertexId> relabelledFaceVertices = faceVertices;
-    for (VertexId fv = 0; fv < faceVertices.size(); fv++) {
-        relabelledFaceVertices[fv] = floatersMapping[faceVertices[fv]];
-    }
-
-    // Re-assign fields
-    vertices = relabelledVertices;
-    faceVertices = relabelledFaceVertices;
-    colours = relaballedColours;
-    firstDirectedEdge = relabelledFirstDirectedEdge;
+    std::vector<VertexId> floatersOrder = exteriorVertices;
+    floatersOrder.insert(floatersOrder.end(), interiorVertices.begin(), interiorVertices.end());
+    relabelVertices(floatersOrder);
+    // Vertex of the mesh as read that every vertex now stands for
+    std::vector<VertexId> originalVertices = floatersOrder;
+
+    if (parameters.ordering != VertexOrdering::None) {
+        // Shuffle the interior block only, the boundary must stay in loop order
+        const std::vector<VertexId> interiorOrder = interiorOrdering(b, parameters);
+        std::vector<VertexId> localityOrder(b + n);
+        for (VertexId v = 0; v < b; v++) {
+            localityOrder[v] = v;
+        }
+        for (VertexId i = 0; i < n; i++) {
+            localityOrder[b + i] = b + interiorOrder[i];
+            originalVertices[b + i] = floatersOrder[b + interiorOrder[i]];
+        }
+        relabelVertices(localityOrder);
+    }
 
+    // Snapshots go out in the labelling the viewer still draws
+    if (parameters.snapshots) {
+        parameters.snapshots->relabel(originalVertices);
+    }
+
+    // Flags moved along with the vertices, only the list needs renaming
     boundaryVertices.clear();
-    boundaryVerticesLookup.clear();
     for (VertexId bv = 0; bv < exteriorVertices.size(); bv++) {
         boundaryVertices.push_back(bv);
-        boundaryVerticesLookup.insert(bv);
     }
 
-    std::cout << "Finished relabelling vertices" << std::endl;
+    log << "Finished relabelling vertices" << std::endl;
 
-    std::cout << "Running Floater's..." << std::endl;
+    log << "Running Floater's..." << std::endl;
 
     // Reset textureCoords
     textureCoords.resize(vertices.size(), {});
@@ -262,29 +898,1264 @@ void TriangleMesh::unwrap() {
     }
 
     // Initially, set all internal vertices to centre of the texture
-    // In addition, compute neighbourhood of each internal vertex
-    std::vector<std::vector<VertexId>> neighbourhoods;
     for (VertexId iv = b; iv < (b + n); iv++) {
         textureCoords[iv] = {0.5f, 0.5f, 0.0f};
-        neighbourhoods.push_back(interiorNeighbourhoodOf(iv));
     }
 
+    if (parameters.snapshots) {
+        parameters.snapshots->publish([&](const VertexId vertex) { return textureCoords[vertex]; });
+    }
+
+    // Every solver mode reads the interior adjacency, and its weights, from the same flat table
+    NeighbourTable table = interiorNeighbourTable(b, parameters.threads);
+    if (parameters.weights == WeightMode::MeanValue) {
+        log << "Computing mean-value weights" << std::endl;
+        assignMeanValueWeights(table, parameters.threads);
+    }
+
+    if (parameters.benchmarkKernels) {
+        benchmarkRelaxation(table);
+    }
+
+    // Mixed precision leaves the last digits to refinement, float sweeps can only reach them by luck
+    UnwrapParameters relaxation = parameters;
+    if (parameters.precision == PrecisionMode::Mixed) {
+        relaxation.tolerance = std::max(parameters.tolerance, MIXED_PRECISION_HANDOFF);
+    }
+
+    UnwrapReport report;
+    const std::unique_ptr<LinearSolver> solver = makeLinearSolver(parameters, table.weights.empty());
+    const bool solved = solver && solveFloaterSystem(*solver, table, monitor, report);
+    if (!solved) {
+        if (solver) {
+            std::cerr << "Solver setup failed, falling back to relaxation" << std::endl;
+        }
+        switch (parameters.solver) {
+            case SolverMode::ParallelRelaxation:
+                report = relaxFloaterColoured(table, relaxation, monitor);
+                break;
+            case SolverMode::OverRelaxation:
+                report = relaxFloaterOverRelaxed(table, relaxation, monitor);
+                break;
+            case SolverMode::BlockedRelaxation:
+                report = relaxFloaterBlocked(table, relaxation, monitor);
+                break;
+            case SolverMode::AsynchronousRelaxation:
+                report = relaxFloaterAsynchronous(table, relaxation, monitor);
+                break;
+            case SolverMode::WorklistRelaxation:
+                report = relaxFloaterWorklist(table, relaxation, monitor);
+                break;
+            default:
+                report = relaxFloater(table, relaxation, monitor);
+                break;
+        }
+
+        if (parameters.precision == PrecisionMode::Mixed && !monitor.stopped()) {
+            refineFloater(table, parameters, monitor, report);
+        }
+    }
+
+    if (filled) {
+        // Drop the hole fillings, the surviving vertices keep their order
+        faceVertices.resize(meshEdges);
+        edgeFlags.resize(meshEdges);
+        faceFlags.resize(meshEdges / 3);
+        std::vector<VertexId> meshOrder;
+        meshOrder.reserve(meshVertices);
+        for (VertexId v = 0; v < vertices.size(); v++) {
+            if (originalVertices[v] < meshVertices) {
+                meshOrder.push_back(v);
+            }
+        }
+        relabelVertices(meshOrder);
+        computeHalfEdge();
+    }
+
+    monitor.finish(report);
+
+    log << "Finished Floater's after " << report.iterations << " iterations"
+              << (report.converged ? "" : " (not converged)")
+              << (report.cancelled ? " (cancelled)" : "")
+              << (report.timedOut ? " (time limit reached)" : "") << std::endl;
+    if (solved) {
+        log << "Final relative residual: " << report.residual << std::endl;
+    } else {
+        log << "Final displacement: max " << report.maxDisplacement
+                  << ", rms " << report.rmsDisplacement << std::endl;
+    }
+
+    return report;
+}
+
+unsigned int TriangleMesh::labelCharts(const ChartMode mode, std::vector<unsigned int>& faceCharts) const {
+    const FaceIndex faceCount = faceVertices.size() / 3;
+    const bool grouped = mode == ChartMode::Groups && faceGroups.size() == faceCount;
+
+    // Faces sharing an edge (and a group, if grouped) belong to the same chart
+    UnionFind components(faceCount);
+    if (mode != ChartMode::Single) {
+        for (EdgeId edgeId = 0; edgeId < faceVertices.size(); edgeId++) {
+            const EdgeId otherEdgeId = otherHalf[edgeId];
+            if (otherEdgeId != NO_SUCH_ELEMENT && edgeId < otherEdgeId
+                && (!grouped || faceGroups[edgeId / 3] == faceGroups[otherEdgeId / 3])) {
+                components.unite(edgeId / 3, otherEdgeId / 3);
+            }
+        }
+    } else {
+        for (FaceIndex face = 1; face < faceCount; face++) {
+            components.unite(0, face);
+        }
+    }
+
+    // Charts are numbered in order of their first face
+    unsigned int chartCount = 0;
+    std::vector<unsigned int> chartOfRoot(faceCount, NO_SUCH_ELEMENT);
+    faceCharts.resize(faceCount);
+    for (FaceIndex face = 0; face < faceCount; face++) {
+        unsigned int& chart = chartOfRoot[components.find(face)];
+        if (chart == NO_SUCH_ELEMENT) {
+            chart = chartCount++;
+        }
+        faceCharts[face] = chart;
+    }
+
+    return chartCount;
+}
+
+std::vector<TriangleMesh> TriangleMesh::splitCharts(
+    const std::vector<unsigned int>& faceCharts,
+    const unsigned int chartCount,
+    std::vector<std::vector<VertexId>>& chartVertices
+) const {
+    const FaceIndex faceCount = faceVertices.size() / 3;
+
+    // Faces bucketed by chart, so that every chart collects its vertices in one go
+    std::vector<FaceIndex> chartFaceOffsets(chartCount + 1, 0);
+    for (FaceIndex face = 0; face < faceCount; face++) {
+        chartFaceOffsets[faceCharts[face] + 1]++;
+    }
+    for (unsigned int chart = 0; chart < chartCount; chart++) {
+        chartFaceOffsets[chart + 1] += chartFaceOffsets[chart];
+    }
+    std::vector<FaceIndex> chartFaces(faceCount);
+    std::vector<FaceIndex> insertAt(chartFaceOffsets.begin(), chartFaceOffsets.end() - 1);
+    for (FaceIndex face = 0; face < faceCount; face++) {
+        chartFaces[insertAt[faceCharts[face]]++] = face;
+    }
+
+    // A vertex shared by several charts gets a copy in each, as it gets a UV in each
+    const bool copyColours = colours.size() == vertices.size();
+    const bool copyNormals = normals.size() == vertices.size();
+    const bool copyGroups = faceGroups.size() == faceCount;
+    std::vector<unsigned int> lastChart(vertices.size(), NO_SUCH_ELEMENT);
+    std::vector<VertexId> chartVertex(vertices.size());
+
+    std::vector<TriangleMesh> charts(chartCount);
+    chartVertices.assign(chartCount, {});
+    for (unsigned int chart = 0; chart < chartCount; chart++) {
+        TriangleMesh& chartMesh = charts[chart];
+        for (FaceIndex f = chartFaceOffsets[chart]; f < chartFaceOffsets[chart + 1]; f++) {
+            const FaceIndex face = chartFaces[f];
+            for (unsigned int corner = 0; corner < 3; corner++) {
+                const VertexId v = faceVertices[3 * face + corner];
+                if (lastChart[v] != chart) {
+                    lastChart[v] = chart;
+                    chartVertex[v] = chartMesh.vertices.size();
+                    chartMesh.vertices.push_back(vertices[v]);
+                    chartVertices[chart].push_back(v);
+                    if (copyColours) {
+                        chartMesh.colours.push_back(colours[v]);
+                    }
+                    if (copyNormals) {
+                        chartMesh.normals.push_back(normals[v]);
+                    }
+                }
+                chartMesh.faceVertices.push_back(chartVertex[v]);
+            }
+            if (copyGroups) {
+                chartMesh.faceGroups.push_back(faceGroups[face]);
+            }
+        }
+    }
+
+    return charts;
+}
+
+UnwrapReport TriangleMesh::unwrapCharts(
+    const std::vector<unsigned int>& faceCharts,
+    const unsigned int chartCount,
+    const UnwrapParameters& parameters,
+    UnwrapMonitor& monitor
+) {
+    std::ostream& log = logStream(parameters.verbose);
+
+    log << "Splitting the mesh into " << chartCount << " charts..." << std::endl;
+
+    std::vector<std::vector<VertexId>> chartVertices;
+    std::vector<TriangleMesh> charts = splitCharts(faceCharts, chartCount, chartVertices);
+
+    // Every chart fills the unit square, it gets a square of the atlas as large as its surface area allows
+    // Sides only depend on the surface, so the atlas is laid out before solving, for snapshots to use
+    std::vector<float> sides(chartCount);
+    for (unsigned int chart = 0; chart < chartCount; chart++) {
+        const TriangleMesh& chartMesh = charts[chart];
+        float area = 0.0f;
+        for (FaceIndex face = 0; face < chartMesh.faceVertices.size(); face += 3) {
+            const Cartesian3& a = chartMesh.vertices[chartMesh.faceVertices[face]];
+            const Cartesian3& b = chartMesh.vertices[chartMesh.faceVertices[face + 1]];
+            const Cartesian3& c = chartMesh.vertices[chartMesh.faceVertices[face + 2]];
+            area += 0.5f * (b - a).cross(c - a).length();
+        }
+        sides[chart] = std::sqrt(area);
+    }
+
+    std::vector<Cartesian3> corners;
+    const float scale = packSquares(sides, corners);
+
+    // Largest charts first, so that the pool does not finish on a long solve
+    // Charts holding at least 1/threads of the faces get every thread to themselves, one after another
+    const unsigned int nThreads = parameters.threads == 0 ? hardwareThreads() : parameters.threads;
+    std::vector<unsigned int> order(chartCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](const unsigned int a, const unsigned int b) {
+        return charts[a].faceVertices.size() > charts[b].faceVertices.size();
+    });
+    unsigned int largeCharts = 0;
+    while (largeCharts < chartCount
+           && nThreads > 1
+           && charts[order[largeCharts]].faceVertices.size() * nThreads >= faceVertices.size()) {
+        largeCharts++;
+    }
+
+    log << "Unwrapping " << chartCount << " charts on " << nThreads << " threads";
+    if (largeCharts > 0) {
+        log << ", the " << largeCharts << " largest one at a time with every thread";
+    }
+    log << std::endl;
+
+    // Each chart is cut and unwrapped on its own, quietly, sharing the cancellation and the time left
+    // Snapshots have a single writer, the largest chart publishes them into its square of the atlas
+    std::vector<UnwrapReport> reports(chartCount);
+    // Charts that even cutting leaves without a boundary get no UVs from unwrapChart
+    std::vector<char> unwrapped(chartCount, 0);
+    const auto unwrapOne = [&](const unsigned int chart, const unsigned int threads) {
+        TriangleMesh& chartMesh = charts[chart];
+        chartMesh.computeHalfEdge();
+        chartMesh.cutToDisk(logStream(false));
+        chartMesh.computeBoundary();
+
+        UnwrapParameters chartParameters = parameters;
+        chartParameters.threads = threads;
+        chartParameters.verbose = false;
+        chartParameters.benchmarkKernels = false;
+        chartParameters.snapshots = chart == order[0] ? parameters.snapshots : nullptr;
+        if (chartParameters.snapshots) {
+            chartParameters.snapshots->place(chartVertices[chart], corners[chart], sides[chart] * scale);
+        }
+        chartParameters.progress = nullptr;
+        if (parameters.timeLimit > 0.0f) {
+            const float remaining = parameters.timeLimit - static_cast<float>(monitor.elapsedSeconds());
+            chartParameters.timeLimit = std::max(remaining, std::numeric_limits<float>::min());
+        }
+
+        UnwrapMonitor chartMonitor(chartParameters);
+        unwrapped[chart] = !chartMesh.boundaryVertices.empty();
+        reports[chart] = chartMesh.unwrapChart(chartParameters, chartMonitor);
+    };
+
+    for (unsigned int i = 0; i < largeCharts; i++) {
+        unwrapOne(order[i], nThreads);
+    }
+
+    std::atomic<unsigned int> nextChart(largeCharts);
+    runOnThreads(std::min(nThreads, chartCount - largeCharts), [&](unsigned int) {
+        for (unsigned int i = nextChart++; i < chartCount; i = nextChart++) {
+            unwrapOne(order[i], 1);
+        }
+    });
+
+    // The charts, one after another, replace the mesh
+    vertices.clear();
+    colours.clear();
+    normals.clear();
+    textureCoords.clear();
+    faceVertices.clear();
+    faceGroups.clear();
+    chartOffsets.assign(1, 0);
+
+    float coverage = 0.0f;
+    UnwrapReport report;
+    report.converged = true;
+    for (unsigned int chart = 0; chart < chartCount; chart++) {
+        const TriangleMesh& chartMesh = charts[chart];
+        const VertexId offset = vertices.size();
+        const float side = sides[chart] * scale;
+        coverage += side * side;
+
+        vertices.insert(vertices.end(), chartMesh.vertices.begin(), chartMesh.vertices.end());
+        colours.insert(colours.end(), chartMesh.colours.begin(), chartMesh.colours.end());
+        normals.insert(normals.end(), chartMesh.normals.begin(), chartMesh.normals.end());
+        if (unwrapped[chart]) {
+            for (const Cartesian3& uv : chartMesh.textureCoords) {
+                textureCoords.push_back(corners[chart] + uv * side);
+            }
+        } else {
+            // Collapsed onto the corner of its square, which keeps the UVs in step with the vertices
+            textureCoords.insert(textureCoords.end(), chartMesh.vertices.size(), corners[chart]);
+            report.converged = false;
+        }
+        for (const VertexId v : chartMesh.faceVertices) {
+            faceVertices.push_back(offset + v);
+        }
+        faceGroups.insert(faceGroups.end(), chartMesh.faceGroups.begin(), chartMesh.faceGroups.end());
+        chartOffsets.push_back(vertices.size());
+
+        const UnwrapReport& chartReport = reports[chart];
+        report.iterations = std::max(report.iterations, chartReport.iterations);
+        report.maxDisplacement = std::max(report.maxDisplacement, chartReport.maxDisplacement);
+        report.rmsDisplacement = std::max(report.rmsDisplacement, chartReport.rmsDisplacement);
+        report.residual = std::max(report.residual, chartReport.residual);
+        report.refinedResidual = std::max(report.refinedResidual, chartReport.refinedResidual);
+        report.converged = report.converged && chartReport.converged;
+    }
+
+    computeHalfEdge();
+    computeBoundary();
+
+    // Picks up cancellation and the time limit as seen by the charts
+    monitor.checkpoint(report.iterations, report.residual > 0.0f ? report.residual : report.maxDisplacement);
+    monitor.finish(report);
+
+    log << "Packed " << chartCount << " charts into the atlas, covering " << 100.0f * coverage
+              << "% of it" << std::endl;
+    log << "Finished Floater's after " << report.iterations << " iterations on the slowest chart"
+              << (report.converged ? "" : " (not converged)")
+              << (report.cancelled ? " (cancelled)" : "")
+              << (report.timedOut ? " (time limit reached)" : "") << std::endl;
+
+    return report;
+}
+
+void TriangleMesh::relabelVertices(const std::vector<VertexId>& order) {
+    std::vector<VertexId> mapping(vertices.size(), NO_SUCH_ELEMENT);
+    for (VertexId v = 0; v < order.size(); v++) {
+        mapping[order[v]] = v;
+    }
+
+    // Optional attributes are only carried over when the file gave one per vertex
+    for (std::vector<Cartesian3>* attribute : {&colours, &normals, &textureCoords}) {
+        if (attribute->size() == vertices.size()) {
+            *attribute = permuted(*attribute, order);
+        } else {
+            attribute->clear();
+        }
+    }
+    if (vertexFlags.size() == vertices.size()) {
+        vertexFlags = permuted(vertexFlags, order);
+    }
+    vertices = permuted(vertices, order);
+    firstDirectedEdge = permuted(firstDirectedEdge, order);
+
+    for (VertexId& faceVertex : faceVertices) {
+        faceVertex = mapping[faceVertex];
+    }
+}
+
+std::vector<VertexId> TriangleMesh::interiorOrdering(const VertexId b, const UnwrapParameters& parameters) const {
+    switch (parameters.ordering) {
+        case VertexOrdering::ReverseCuthillMcKee:
+            logStream(parameters.verbose) << "Reordering interior vertices by reverse Cuthill-McKee" << std::endl;
+            return reverseCuthillMcKeeOrdering(interiorNeighbourTable(b, parameters.threads));
+        case VertexOrdering::Morton:
+            logStream(parameters.verbose) << "Reordering interior vertices along a Morton curve" << std::endl;
+            return mortonOrdering(std::vector<Cartesian3>(vertices.begin() + b, vertices.end()));
+        case VertexOrdering::Hilbert:
+            logStream(parameters.verbose) << "Reordering interior vertices along a Hilbert curve" << std::endl;
+            return hilbertOrdering(std::vector<Cartesian3>(vertices.begin() + b, vertices.end()));
+        default: {
+            std::vector<VertexId> identity(vertices.size() - b);
+            for (VertexId i = 0; i < identity.size(); i++) {
+                identity[i] = i;
+            }
+            return identity;
+        }
+    }
+}
+
+UnwrapReport TriangleMesh::relaxFloater(
+    const NeighbourTable& table,
+    const UnwrapParameters& parameters,
+    UnwrapMonitor& monitor
+) {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+    std::vector<float> u;
+    std::vector<float> v;
+    splitTextureCoords(u, v);
+
+    const std::unique_ptr<SweepAccelerator> accelerator = startSweepAccelerator(b, b + n, u, v, parameters);
+
     // Compute internal vertices UVs using Floater's loop
-    for (unsigned int i = 0; i < N_ITERATIONS; i++) {
-        for (VertexId iv = b; iv < (b + n); iv++) {
-            Cartesian3 weightedUv;
-            const auto& neighbourhood = neighbourhoods[iv - b];
+    // Each sweep tracks how far the UVs moved, the loop stops once that falls below the tolerance
+    UnwrapReport report;
+    while (report.iterations < parameters.maxIterations && !report.converged) {
+        const SweepStatistics sweep = relaxRange(table, b, b + n, u.data(), v.data());
+
+        report.iterations++;
+        report.maxDisplacement = std::sqrt(sweep.maxDisplacementSquared);
+        report.rmsDisplacement = n > 0 ? static_cast<float>(std::sqrt(sweep.sumDisplacementSquared / n)) : 0.0f;
+        report.converged = report.maxDisplacement < parameters.tolerance;
+
+        if (report.converged || monitor.checkpoint(report.iterations, report.maxDisplacement, u, v)) {
+            break;
+        }
+        if (accelerator) {
+            accelerator->accelerate(sweep, u.data(), v.data());
+        }
+    }
+
+    mergeTextureCoords(b, u, v);
+    return report;
+}
+
+UnwrapReport TriangleMesh::relaxFloaterOverRelaxed(
+    const NeighbourTable& table,
+    const UnwrapParameters& parameters,
+    UnwrapMonitor& monitor
+) {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+    std::vector<float> u;
+    std::vector<float> v;
+    splitTextureCoords(u, v);
+
+    // Start as plain Gauss-Seidel, raise omega towards the estimated optimum and back off when progress stalls
+    float omega = 1.0f;
+    double midwayDisplacement = 0.0;
+
+    UnwrapReport report;
+    while (report.iterations < parameters.maxIterations && !report.converged) {
+        const SweepStatistics sweep = relaxRangeOverRelaxed(table, b, b + n, omega, u.data(), v.data());
+
+        report.iterations++;
+        report.maxDisplacement = std::sqrt(sweep.maxDisplacementSquared);
+        report.rmsDisplacement = n > 0 ? static_cast<float>(std::sqrt(sweep.sumDisplacementSquared / n)) : 0.0f;
+        report.converged = report.maxDisplacement < parameters.tolerance;
+
+        const unsigned int windowSweep = report.iterations % SOR_ADAPT_SWEEPS;
+        if (windowSweep == SOR_ADAPT_SWEEPS / 2) {
+            midwayDisplacement = std::sqrt(sweep.sumDisplacementSquared);
+        } else if (windowSweep == 0 && midwayDisplacement > 0.0) {
+            // Observed convergence factor per sweep, over the second half of the window
+            const double rate = std::pow(std::sqrt(sweep.sumDisplacementSquared) / midwayDisplacement,
+                                         2.0 / SOR_ADAPT_SWEEPS);
+
+            if (rate >= 1.0) {
+                // Diverging, or stuck at float precision: back off towards plain Gauss-Seidel, which settles
+                omega = 1.0f + (omega - 1.0f) / 2.0f;
+            } else if (report.maxDisplacement > SOR_ESTIMATE_FLOOR &&
+                       rate - (omega - 1.0) > SOR_ESTIMATE_GAP * (2.0 - omega)) {
+                // Below the optimum the rate stays clear of omega - 1, and Young's relation
+                // (rate + omega - 1)^2 = rate * omega^2 * rhoJ^2 gives the Jacobi spectral radius,
+                // and from it the optimal omega = 2 / (1 + sqrt(1 - rhoJ^2))
+                // At or past the optimum the rate sits at omega - 1 and says nothing, so omega is left alone
+                const double jacobiRadiusSquared = std::min(
+                    1.0, (rate + omega - 1.0) * (rate + omega - 1.0) / (rate * omega * omega)
+                );
+                const double optimal = 2.0 / (1.0 + std::sqrt(1.0 - jacobiRadiusSquared));
+                omega = static_cast<float>(std::min(SOR_MAX_OMEGA, std::max(static_cast<double>(omega), optimal)));
+            }
+        }
+
+        if (monitor.checkpoint(report.iterations, report.maxDisplacement, u, v)) {
+            break;
+        }
+    }
+
+    logStream(parameters.verbose) << "Final over-relaxation factor: " << omega << std::endl;
+
+    mergeTextureCoords(b, u, v);
+    return report;
+}
+
+UnwrapReport TriangleMesh::relaxFloaterBlocked(
+    const NeighbourTable& table,
+    const UnwrapParameters& parameters,
+    UnwrapMonitor& monitor
+) {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+    const VertexId nTiles = (n + RELAXATION_TILE_VERTICES - 1) / RELAXATION_TILE_VERTICES;
+    std::vector<float> u;
+    std::vector<float> v;
+    splitTextureCoords(u, v);
+
+    logStream(parameters.verbose) << "Relaxing " << nTiles << " tiles of up to " << RELAXATION_TILE_VERTICES
+                                  << " vertices, " << RELAXATION_TILE_SWEEPS << " sweeps each" << std::endl;
+
+    UnwrapReport report;
+    while (report.iterations < parameters.maxIterations && !report.converged) {
+        // Only the first sweep of every tile counts towards convergence: it is the one that sees
+        // what changed elsewhere since the tile was last visited
+        SweepStatistics pass;
+
+        for (VertexId tileBegin = b; tileBegin < b + n; tileBegin += RELAXATION_TILE_VERTICES) {
+            const VertexId tileEnd = std::min(b + n, tileBegin + RELAXATION_TILE_VERTICES);
+
+            // The tile is cold on its first sweep, later ones find it (and its halo) in cache
+            const SweepStatistics first = relaxRangePrefetched(table, tileBegin, tileEnd, u.data(), v.data());
+            pass.merge(first);
+
+            // Neighbours outside the tile (its halo) are frozen meanwhile, so extra sweeps only
+            // pay off while the tile itself is still moving
+            float displacementSquared = first.maxDisplacementSquared;
+            for (unsigned int sweep = 1; sweep < RELAXATION_TILE_SWEEPS; sweep++) {
+                if (displacementSquared < parameters.tolerance * parameters.tolerance) {
+                    break;
+                }
+                displacementSquared = relaxRange(table, tileBegin, tileEnd, u.data(), v.data()).maxDisplacementSquared;
+            }
+        }
+
+        report.iterations++;
+        report.maxDisplacement = std::sqrt(pass.maxDisplacementSquared);
+        report.rmsDisplacement = n > 0 ? static_cast<float>(std::sqrt(pass.sumDisplacementSquared / n)) : 0.0f;
+        report.converged = report.maxDisplacement < parameters.tolerance;
+
+        if (monitor.checkpoint(report.iterations, report.maxDisplacement, u, v)) {
+            break;
+        }
+    }
+
+    mergeTextureCoords(b, u, v);
+    return report;
+}
+
+UnwrapReport TriangleMesh::relaxFloaterColoured(
+    const NeighbourTable& table,
+    const UnwrapParameters& parameters,
+    UnwrapMonitor& monitor
+) {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+    const unsigned int nThreads = parameters.threads > 0 ? parameters.threads : hardwareThreads();
+
+    // Each class is split by valence, so that most of it goes through kernels unrolled for its neighbour count
+    std::vector<std::vector<ValenceBucket>> colourClasses;
+    for (const auto& colourClass : greedyColourClasses(table)) {
+        colourClasses.push_back(bucketByValence(table, colourClass));
+    }
+
+    std::vector<float> u;
+    std::vector<float> v;
+    splitTextureCoords(u, v);
+
+    // Every kernel computes the same UVs, so picking the fastest one does not change the result
+    const KernelIsa isa = fastestIsa(table, colourClasses, u, v);
+    std::vector<std::vector<IndependentRelaxationKernel>> kernels;
+    for (const auto& colourClass : colourClasses) {
+        kernels.emplace_back();
+        for (const ValenceBucket& bucket : colourClass) {
+            kernels.back().push_back(independentRelaxationKernel(isa, !table.weights.empty(), bucket.valence));
+        }
+    }
+
+    logStream(parameters.verbose) << "Relaxing " << colourClasses.size() << " colour classes on " << nThreads
+                                  << " threads (" << isaName(isa) << " kernel)" << std::endl;
+
+    const std::unique_ptr<SweepAccelerator> accelerator = startSweepAccelerator(b, b + n, u, v, parameters);
+
+    // Per-thread displacement partials, reduced by thread 0 after every sweep
+    std::vector<SweepStatistics> threadStatistics(nThreads);
+    UnwrapReport report;
+    bool stop = parameters.maxIterations == 0;
+    Barrier barrier(nThreads);
+
+    runOnThreads(nThreads, [&](const unsigned int thread) {
+        while (!stop) {
+            SweepStatistics statistics;
+
+            for (unsigned int c = 0; c < colourClasses.size(); c++) {
+                for (unsigned int k = 0; k < colourClasses[c].size(); k++) {
+                    // Static partition: every thread owns the same slice of a bucket on every sweep
+                    const std::vector<VertexId>& bucket = colourClasses[c][k].vertices;
+                    const VertexId begin = bucket.size() * thread / nThreads;
+                    const VertexId end = bucket.size() * (thread + 1) / nThreads;
+
+                    statistics.merge(kernels[c][k](table, bucket.data() + begin, end - begin, u.data(), v.data()));
+                }
+
+                // The next class reads what this one wrote
+                barrier.arriveAndWait();
+            }
+
+            threadStatistics[thread] = statistics;
+            barrier.arriveAndWait();
+
+            if (thread == 0) {
+                SweepStatistics sweep;
+                for (const auto& partial : threadStatistics) {
+                    sweep.merge(partial);
+                }
+
+                report.iterations++;
+                report.maxDisplacement = std::sqrt(sweep.maxDisplacementSquared);
+                report.rmsDisplacement = n > 0 ? static_cast<float>(std::sqrt(sweep.sumDisplacementSquared / n)) : 0.0f;
+                report.converged = report.maxDisplacement < parameters.tolerance;
+                stop = report.converged || report.iterations >= parameters.maxIterations ||
+                       monitor.checkpoint(report.iterations, report.maxDisplacement, u, v);
+
+                // Extrapolates while the other threads wait at the barrier below
+                if (accelerator && !stop) {
+                    accelerator->accelerate(sweep, u.data(), v.data());
+                }
+            }
+            barrier.arriveAndWait();
+        }
+    });
+
+    mergeTextureCoords(b, u, v);
+    return report;
+}
+
+UnwrapReport TriangleMesh::relaxFloaterAsynchronous(
+    const NeighbourTable& table,
+    const UnwrapParameters& parameters,
+    UnwrapMonitor& monitor
+) {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+    const unsigned int nThreads = parameters.threads > 0 ? parameters.threads : hardwareThreads();
+
+    logStream(parameters.verbose) << "Relaxing asynchronously on " << nThreads << " threads" << std::endl;
+
+    // std::atomic mirrors of the UVs, so concurrent reads and writes of a vertex are well defined
+    std::vector<std::atomic<float>> u(b + n);
+    std::vector<std::atomic<float>> v(b + n);
+    for (VertexId vertex = 0; vertex < b + n; vertex++) {
+        u[vertex].store(textureCoords[vertex].x, std::memory_order_relaxed);
+        v[vertex].store(textureCoords[vertex].y, std::memory_order_relaxed);
+    }
+
+    // What each thread saw on its latest sweep, one cache line per thread
+    struct alignas(64) SweepProgress {
+        std::atomic<unsigned int> sweeps{0};
+        // Value of disturbances when the latest sweep started, if that sweep settled
+        std::atomic<unsigned int> settledSince{NO_SUCH_ELEMENT};
+    };
+    std::vector<SweepProgress> progress(nThreads);
+
+    // Counts sweeps that moved some vertex by at least the tolerance
+    // A thread that settled against values a later disturbance has since changed must sweep again
+    std::atomic<unsigned int> disturbances(0);
+    std::atomic<bool> stop(parameters.maxIterations == 0);
+    // Why the threads stopped: only global settlement counts as converged, the other threads may be
+    // mid-sweep when it is detected, so their latest sweeps say nothing about it
+    std::atomic<bool> settledGlobally(false);
+
+    runOnThreads(nThreads, [&](const unsigned int thread) {
+        const VertexId begin = b + n * thread / nThreads;
+        const VertexId end = b + n * (thread + 1) / nThreads;
+        SweepProgress& own = progress[thread];
+
+        for (unsigned int sweep = 1; !stop.load(std::memory_order_relaxed); sweep++) {
+            const unsigned int startedAt = disturbances.load(std::memory_order_acquire);
+            float maxDisplacementSquared = 0.0f;
+
+            for (VertexId iv = begin; iv < end; iv++) {
+                float weightedU = 0.0f;
+                float weightedV = 0.0f;
+                const VertexId row = iv - b;
+
+                for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+                    weightedU += table.weight(entry) * u[table.neighbours[entry]].load(std::memory_order_relaxed);
+                    weightedV += table.weight(entry) * v[table.neighbours[entry]].load(std::memory_order_relaxed);
+                }
+                weightedU *= table.inverseWeightSum[row];
+                weightedV *= table.inverseWeightSum[row];
+
+                const float du = weightedU - u[iv].load(std::memory_order_relaxed);
+                const float dv = weightedV - v[iv].load(std::memory_order_relaxed);
+                maxDisplacementSquared = std::max(maxDisplacementSquared, du * du + dv * dv);
+
+                u[iv].store(weightedU, std::memory_order_relaxed);
+                v[iv].store(weightedV, std::memory_order_relaxed);
+            }
+
+            const float maxDisplacement = std::sqrt(maxDisplacementSquared);
+            own.sweeps.store(sweep, std::memory_order_relaxed);
+
+            if (maxDisplacement < parameters.tolerance) {
+                own.settledSince.store(startedAt, std::memory_order_release);
+            } else {
+                own.settledSince.store(NO_SUCH_ELEMENT, std::memory_order_release);
+                disturbances.fetch_add(1, std::memory_order_acq_rel);
+            }
+
+            // Global residual estimate: every thread settled on a sweep that started after the last disturbance
+            const unsigned int current = disturbances.load(std::memory_order_acquire);
+            bool settled = true;
+            for (const auto& other : progress) {
+                settled = settled && other.settledSince.load(std::memory_order_acquire) == current;
+            }
+
+            // Snapshots read the UVs through the atomics too, mid-sweep for the other threads
+            const bool interrupted = thread == 0 && monitor.checkpoint(sweep, maxDisplacement, u, v);
+            if (settled) {
+                settledGlobally.store(true, std::memory_order_relaxed);
+            }
+            if (settled || sweep >= parameters.maxIterations || interrupted) {
+                stop.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    UnwrapReport report;
+    for (const auto& threadProgress : progress) {
+        report.iterations = std::max(report.iterations, threadProgress.sweeps.load());
+    }
+    report.converged = settledGlobally.load();
+
+    // Displacements of one more Jacobi sweep over the final UVs, without applying it
+    // The threads' latest sweeps overlapped each other, this is what the UVs handed back actually satisfy
+    double sumDisplacementSquared = 0.0;
+    for (VertexId row = 0; row < n; row++) {
+        float weightedU = 0.0f;
+        float weightedV = 0.0f;
+        for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+            weightedU += table.weight(entry) * u[table.neighbours[entry]].load(std::memory_order_relaxed);
+            weightedV += table.weight(entry) * v[table.neighbours[entry]].load(std::memory_order_relaxed);
+        }
+        const float du = weightedU * table.inverseWeightSum[row] - u[b + row].load(std::memory_order_relaxed);
+        const float dv = weightedV * table.inverseWeightSum[row] - v[b + row].load(std::memory_order_relaxed);
+        const float displacementSquared = du * du + dv * dv;
+        report.maxDisplacement = std::max(report.maxDisplacement, std::sqrt(displacementSquared));
+        sumDisplacementSquared += displacementSquared;
+    }
+    report.rmsDisplacement = n > 0 ? static_cast<float>(std::sqrt(sumDisplacementSquared / n)) : 0.0f;
+
+    for (VertexId iv = b; iv < b + n; iv++) {
+        textureCoords[iv] = Cartesian3(u[iv].load(), v[iv].load(), 0.0f);
+    }
+
+    return report;
+}
+
+UnwrapReport TriangleMesh::relaxFloaterWorklist(
+    const NeighbourTable& table,
+    const UnwrapParameters& parameters,
+    UnwrapMonitor& monitor
+) {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+    const unsigned int nThreads = parameters.threads > 0 ? parameters.threads : hardwareThreads();
+    const float tolerance = parameters.tolerance;
+
+    logStream(parameters.verbose) << "Relaxing from worklists on " << nThreads << " threads" << std::endl;
+
+    std::vector<std::atomic<float>> u(b + n);
+    std::vector<std::atomic<float>> v(b + n);
+    for (VertexId vertex = 0; vertex < b + n; vertex++) {
+        u[vertex].store(textureCoords[vertex].x, std::memory_order_relaxed);
+        v[vertex].store(textureCoords[vertex].y, std::memory_order_relaxed);
+    }
 
-            for (const unsigned int neighbour : neighbourhood) {
-                weightedUv = weightedUv + textureCoords[neighbour];
+    // pending[i] bounds how far the average of interior row i moved since it was last relaxed
+    // Rows are queued once that reaches the tolerance, queued[i] keeps them in at most one queue
+    std::vector<std::atomic<float>> pending(n);
+    std::vector<std::atomic<bool>> queued(n);
+    // Every thread owns a queue for a contiguous slice of rows, and steals from the others when it runs dry
+    std::vector<BucketQueue> queues(nThreads);
+    const auto ownerOf = [&](const VertexId row) {
+        return static_cast<unsigned int>(static_cast<unsigned long long>(row) * nThreads / n);
+    };
+
+    // Weights need not be symmetric, so a move is propagated with the largest share any neighbour has in a row
+    std::vector<float> largestShare(n, 0.0f);
+    for (VertexId row = 0; row < n; row++) {
+        for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+            largestShare[row] = std::max(largestShare[row], table.weight(entry) * table.inverseWeightSum[row]);
+        }
+    }
+
+    // Rows queued or being relaxed, the worklists are drained once this reaches 0
+    std::atomic<unsigned int> outstanding(0);
+
+    // Budget in vertex updates, parameters.maxIterations counts full sweeps
+    const unsigned long long maxUpdates = static_cast<unsigned long long>(parameters.maxIterations) * n;
+    std::atomic<unsigned long long> updates(0);
+    std::atomic<bool> stop(maxUpdates == 0);
+
+    // Every row starts queued, in index order, so the first pass is a plain sweep
+    for (VertexId row = 0; row < n; row++) {
+        pending[row].store(0.0f, std::memory_order_relaxed);
+        queued[row].store(true, std::memory_order_relaxed);
+    }
+    const std::vector<float> seedKeys(n, std::numeric_limits<float>::infinity());
+    std::vector<VertexId> seedRows(n);
+    for (VertexId row = 0; row < n; row++) {
+        seedRows[row] = row;
+    }
+    for (unsigned int thread = 0; thread < nThreads; thread++) {
+        const VertexId begin = n * thread / nThreads;
+        const VertexId end = n * (thread + 1) / nThreads;
+        queues[thread].push(seedRows.data() + begin, seedKeys.data() + begin, end - begin);
+    }
+    outstanding.store(n);
+
+    UnwrapReport report;
+    // Unknown until the worklists first drain and every row is checked
+    report.maxDisplacement = std::numeric_limits<float>::infinity();
+    while (true) {
+        runOnThreads(nThreads, [&](const unsigned int thread) {
+            std::vector<VertexId> batch(WORKLIST_BATCH);
+            // Rows to queue, per owning thread, flushed after every batch
+            std::vector<std::vector<VertexId>> outgoingRows(nThreads);
+            std::vector<std::vector<float>> outgoingKeys(nThreads);
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                unsigned int batchSize = queues[thread].pop(batch.data(), WORKLIST_BATCH);
+                for (unsigned int other = 1; batchSize == 0 && other < nThreads; other++) {
+                    batchSize = queues[(thread + other) % nThreads].trySteal(batch.data(), WORKLIST_BATCH);
+                }
+
+                if (batchSize == 0) {
+                    if (outstanding.load(std::memory_order_acquire) == 0) {
+                        return;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                unsigned int queuedCount = 0;
+                for (unsigned int k = 0; k < batchSize; k++) {
+                    const VertexId row = batch[k];
+
+                    // Cleared before reading the neighbours, so moves made meanwhile queue the row again
+                    queued[row].store(false, std::memory_order_release);
+                    pending[row].store(0.0f, std::memory_order_release);
+
+                    float weightedU = 0.0f;
+                    float weightedV = 0.0f;
+                    for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+                        weightedU += table.weight(entry) * u[table.neighbours[entry]].load(std::memory_order_relaxed);
+                        weightedV += table.weight(entry) * v[table.neighbours[entry]].load(std::memory_order_relaxed);
+                    }
+                    weightedU *= table.inverseWeightSum[row];
+                    weightedV *= table.inverseWeightSum[row];
+
+                    const VertexId iv = b + row;
+                    const float du = weightedU - u[iv].load(std::memory_order_relaxed);
+                    const float dv = weightedV - v[iv].load(std::memory_order_relaxed);
+                    u[iv].store(weightedU, std::memory_order_relaxed);
+                    v[iv].store(weightedV, std::memory_order_relaxed);
+
+                    // Averages are linear, so every interior neighbour moves by its share of this displacement
+                    const float displacement = std::sqrt(du * du + dv * dv);
+                    if (displacement == 0.0f) {
+                        continue;
+                    }
+
+                    for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+                        if (table.neighbours[entry] < b) {
+                            continue;
+                        }
+
+                        const VertexId neighbour = table.neighbours[entry] - b;
+                        const float moved = atomicAdd(pending[neighbour], displacement * largestShare[neighbour]);
+                        if (moved >= tolerance &&
+                            !queued[neighbour].load(std::memory_order_relaxed) &&
+                            !queued[neighbour].exchange(true, std::memory_order_acq_rel)) {
+                            outgoingRows[ownerOf(neighbour)].push_back(neighbour);
+                            outgoingKeys[ownerOf(neighbour)].push_back(moved / tolerance);
+                            queuedCount++;
+                        }
+                    }
+                }
+
+                // The batch is only retired after its rows are queued, so outstanding cannot reach 0 early
+                outstanding.fetch_add(queuedCount, std::memory_order_acq_rel);
+                for (unsigned int owner = 0; owner < nThreads; owner++) {
+                    if (!outgoingRows[owner].empty()) {
+                        queues[owner].push(outgoingRows[owner].data(), outgoingKeys[owner].data(), outgoingRows[owner].size());
+                        outgoingRows[owner].clear();
+                        outgoingKeys[owner].clear();
+                    }
+                }
+                outstanding.fetch_sub(batchSize, std::memory_order_acq_rel);
+
+                const unsigned long long updated = updates.fetch_add(batchSize, std::memory_order_relaxed) + batchSize;
+                // Checked per batch, but only by one thread, the others see stop
+                const bool interrupted = thread == 0 && monitor.checkpoint(updated / n, report.maxDisplacement, u, v);
+                if (updated >= maxUpdates || interrupted) {
+                    stop.store(true, std::memory_order_relaxed);
+                }
             }
-            weightedUv = weightedUv / neighbourhood.size();
+        });
+
+        // Check every row once the worklists drain, anything the bounds missed is queued again
+        double sumDisplacementSquared = 0.0;
+        report.maxDisplacement = 0.0f;
+        for (VertexId row = 0; row < n; row++) {
+            float weightedU = 0.0f;
+            float weightedV = 0.0f;
+            for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+                weightedU += table.weight(entry) * u[table.neighbours[entry]].load(std::memory_order_relaxed);
+                weightedV += table.weight(entry) * v[table.neighbours[entry]].load(std::memory_order_relaxed);
+            }
+
+            const float du = weightedU * table.inverseWeightSum[row] - u[b + row].load(std::memory_order_relaxed);
+            const float dv = weightedV * table.inverseWeightSum[row] - v[b + row].load(std::memory_order_relaxed);
+            const float displacement = std::sqrt(du * du + dv * dv);
+            report.maxDisplacement = std::max(report.maxDisplacement, displacement);
+            sumDisplacementSquared += displacement * displacement;
+
+            if (displacement >= tolerance && !stop.load(std::memory_order_relaxed)) {
+                const float key = displacement / tolerance;
+                pending[row].store(displacement, std::memory_order_relaxed);
+                queued[row].store(true, std::memory_order_relaxed);
+                outstanding.fetch_add(1, std::memory_order_relaxed);
+                queues[ownerOf(row)].push(&row, &key, 1);
+            }
+        }
+        report.rmsDisplacement = n > 0 ? static_cast<float>(std::sqrt(sumDisplacementSquared / n)) : 0.0f;
+        report.converged = report.maxDisplacement < tolerance;
+
+        if (report.converged || stop.load(std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    // In sweeps' worth of vertex updates, to compare with the sweeping modes
+    report.iterations = n > 0 ? static_cast<unsigned int>((updates.load() + n - 1) / n) : 0;
+    logStream(parameters.verbose) << "Relaxed " << updates.load() << " vertices, " << report.iterations
+                                  << " sweeps' worth" << std::endl;
+
+    for (VertexId iv = b; iv < b + n; iv++) {
+        textureCoords[iv] = Cartesian3(u[iv].load(), v[iv].load(), 0.0f);
+    }
+
+    return report;
+}
+
+void TriangleMesh::refineFloater(
+    const NeighbourTable& table,
+    const UnwrapParameters& parameters,
+    UnwrapMonitor& monitor,
+    UnwrapReport& report
+) {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+
+    // The solution is accumulated in double, only the corrections are relaxed in float
+    std::vector<double> u(b + n);
+    std::vector<double> v(b + n);
+    for (VertexId vertex = 0; vertex < b + n; vertex++) {
+        u[vertex] = textureCoords[vertex].x;
+        v[vertex] = textureCoords[vertex].y;
+    }
+    std::vector<double> ru(n);
+    std::vector<double> rv(n);
+    std::vector<float> residualU(n);
+    std::vector<float> residualV(n);
+    std::vector<float> eu(b + n);
+    std::vector<float> ev(b + n);
+
+    double residual = floaterResidual(table, u.data(), v.data(), ru.data(), rv.data());
+    const double singleResidual = residual;
+    unsigned int steps = 0;
+
+    bool interrupted = false;
+
+    while (residual >= parameters.tolerance && report.iterations < parameters.maxIterations && !interrupted) {
+        for (VertexId row = 0; row < n; row++) {
+            residualU[row] = static_cast<float>(ru[row]);
+            residualV[row] = static_cast<float>(rv[row]);
+        }
+        std::fill(eu.begin(), eu.end(), 0.0f);
+        std::fill(ev.begin(), ev.end(), 0.0f);
+
+        // Solve e = average(e) + r only roughly: every step cuts the residual by about REFINEMENT_REDUCTION,
+        // but no further than the tolerance needs
+        const double target = std::max(REFINEMENT_REDUCTION * residual, 0.5 * parameters.tolerance);
+        const std::unique_ptr<SweepAccelerator> accelerator = makeSweepAccelerator(parameters.acceleration);
+        if (accelerator) {
+            accelerator->start(b, b + n, eu.data(), ev.data());
+        }
+        while (report.iterations < parameters.maxIterations && !interrupted) {
+            const SweepStatistics sweep = relaxCorrectionRange(
+                table, b, b + n, residualU.data(), residualV.data(), eu.data(), ev.data()
+            );
+            report.iterations++;
+            report.maxDisplacement = std::sqrt(sweep.maxDisplacementSquared);
+            report.rmsDisplacement = n > 0 ? static_cast<float>(std::sqrt(sweep.sumDisplacementSquared / n)) : 0.0f;
+
+            // Corrections are relaxed from 0, the solution itself only moves once the step is done
+            interrupted = monitor.checkpoint(report.iterations, static_cast<float>(residual));
+            if (report.maxDisplacement < target) {
+                break;
+            }
+            if (accelerator) {
+                accelerator->accelerate(sweep, eu.data(), ev.data());
+            }
+        }
+
+        for (VertexId iv = b; iv < b + n; iv++) {
+            u[iv] += eu[iv];
+            v[iv] += ev[iv];
+        }
+        steps++;
+        if (monitor.checkpoint(report.iterations, static_cast<float>(residual), u, v)) {
+            interrupted = true;
+        }
 
-            textureCoords[iv] = weightedUv;
+        // A step that barely helps means the corrections are lost in float round-off, more will not help
+        const double previousResidual = residual;
+        residual = floaterResidual(table, u.data(), v.data(), ru.data(), rv.data());
+        if (!(residual < REFINEMENT_MIN_GAIN * previousResidual)) {
+            break;
         }
     }
 
-    std::cout << "Finished Floater's" << std::endl;
+    report.refinedResidual = residual;
+    report.converged = residual < parameters.tolerance;
+
+    logStream(parameters.verbose) << "Refined in double precision over " << steps << " steps: residual " << residual
+              << ", from " << singleResidual << " after single-precision sweeps" << std::endl;
+
+    for (VertexId iv = b; iv < b + n; iv++) {
+        textureCoords[iv] = Cartesian3(static_cast<float>(u[iv]), static_cast<float>(v[iv]), 0.0f);
+    }
+}
+
+std::unique_ptr<SweepAccelerator> TriangleMesh::startSweepAccelerator(
+    const VertexId begin,
+    const VertexId end,
+    const std::vector<float>& u,
+    const std::vector<float>& v,
+    const UnwrapParameters& parameters
+) const {
+    std::unique_ptr<SweepAccelerator> accelerator = makeSweepAccelerator(parameters.acceleration);
+
+    if (accelerator) {
+        logStream(parameters.verbose) << "Accelerating sweeps with "
+                  << (parameters.acceleration == AccelerationMode::Chebyshev ? "Chebyshev semi-iteration" : "Anderson mixing")
+                  << std::endl;
+        accelerator->start(begin, end, u.data(), v.data());
+    }
+
+    return accelerator;
+}
+
+void TriangleMesh::splitTextureCoords(std::vector<float>& u, std::vector<float>& v) const {
+    u.resize(textureCoords.size());
+    v.resize(textureCoords.size());
+
+    for (VertexId vertex = 0; vertex < textureCoords.size(); vertex++) {
+        u[vertex] = textureCoords[vertex].x;
+        v[vertex] = textureCoords[vertex].y;
+    }
+}
+
+void TriangleMesh::mergeTextureCoords(const VertexId b, const std::vector<float>& u, const std::vector<float>& v) {
+    for (VertexId vertex = b; vertex < textureCoords.size(); vertex++) {
+        textureCoords[vertex] = Cartesian3(u[vertex], v[vertex], 0.0f);
+    }
+}
+
+void TriangleMesh::benchmarkRelaxation(const NeighbourTable& table) const {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+    if (n == 0) {
+        return;
+    }
+
+    // Enough sweeps for roughly 10^8 vertex updates, at least one
+    const unsigned int sweeps = std::max(1u, BENCHMARK_VERTEX_UPDATES / n);
+    const auto nanosecondsPerUpdate = [&](const std::chrono::steady_clock::duration elapsed) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(sweeps) * n);
+    };
+
+    std::cout << "Benchmarking relaxation kernels over " << sweeps << " sweeps of " << n << " vertices" << std::endl;
+
+    // Baseline: the original array-of-structures loop over Cartesian3
+    {
+        std::vector<Cartesian3> uvs = textureCoords;
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int sweep = 0; sweep < sweeps; sweep++) {
+            for (VertexId iv = b; iv < (b + n); iv++) {
+                Cartesian3 weightedUv;
+                const VertexId row = iv - b;
+
+                for (unsigned int entry = table.offsets[row]; entry < table.offsets[row + 1]; entry++) {
+                    weightedUv = weightedUv + table.weight(entry) * uvs[table.neighbours[entry]];
+                }
+                uvs[iv] = weightedUv * table.inverseWeightSum[row];
+            }
+        }
+        std::cout << "  Cartesian3 loop:      " << nanosecondsPerUpdate(std::chrono::steady_clock::now() - start)
+                  << " ns/vertex" << std::endl;
+    }
+
+    std::vector<float> u;
+    std::vector<float> v;
+
+    {
+        splitTextureCoords(u, v);
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int sweep = 0; sweep < sweeps; sweep++) {
+            relaxRange(table, b, b + n, u.data(), v.data());
+        }
+        std::cout << "  Flat scalar loop:     " << nanosecondsPerUpdate(std::chrono::steady_clock::now() - start)
+                  << " ns/vertex" << std::endl;
+    }
+
+    // Vector kernels need independent vertices, so they sweep colour classes
+    const std::vector<std::vector<VertexId>> colourClasses = greedyColourClasses(table);
+    std::vector<std::vector<ValenceBucket>> bucketedClasses;
+    for (const auto& colourClass : colourClasses) {
+        bucketedClasses.push_back(bucketByValence(table, colourClass));
+    }
+
+    for (const KernelIsa isa : {KernelIsa::Scalar, KernelIsa::SSE, KernelIsa::AVX2, KernelIsa::AVX512}) {
+        if (!isaSupported(isa)) {
+            continue;
+        }
+
+        // Generic kernel over whole classes
+        {
+            const IndependentRelaxationKernel kernel = independentRelaxationKernel(isa, !table.weights.empty());
+            splitTextureCoords(u, v);
+            const auto start = std::chrono::steady_clock::now();
+            for (unsigned int sweep = 0; sweep < sweeps; sweep++) {
+                for (const auto& colourClass : colourClasses) {
+                    kernel(table, colourClass.data(), colourClass.size(), u.data(), v.data());
+                }
+            }
+            std::cout << "  Coloured " << std::left << std::setw(12) << isaName(isa) << std::right
+                      << nanosecondsPerUpdate(std::chrono::steady_clock::now() - start) << " ns/vertex" << std::endl;
+        }
+
+        // Unrolled kernels over the valence buckets of every class
+        {
+            splitTextureCoords(u, v);
+            const auto start = std::chrono::steady_clock::now();
+            for (unsigned int sweep = 0; sweep < sweeps; sweep++) {
+                for (const auto& colourClass : bucketedClasses) {
+                    for (const ValenceBucket& bucket : colourClass) {
+                        independentRelaxationKernel(isa, !table.weights.empty(), bucket.valence)(
+                            table, bucket.vertices.data(), bucket.vertices.size(), u.data(), v.data()
+                        );
+                    }
+                }
+            }
+            std::cout << "  Bucketed " << std::left << std::setw(12) << isaName(isa) << std::right
+                      << nanosecondsPerUpdate(std::chrono::steady_clock::now() - start) << " ns/vertex" << std::endl;
+        }
+    }
+}
+
+void TriangleMesh::assembleFloaterSystem(
+    const NeighbourTable& table,
+    SparseMatrix& matrix,
+    std::vector<double>& rhsU,
+    std::vector<double>& rhsV
+) const {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+
+    // Row i reads deg(i) * uv(i) - sum(interior neighbours) = sum(boundary neighbours)
+    // Scaling by the degree (instead of averaging) keeps the matrix symmetric for uniform weights
+    // With weights, the degree becomes the weight sum and every neighbour is scaled by its weight
+    std::vector<unsigned int> rows;
+    std::vector<unsigned int> columns;
+    std::vector<double> values;
+    rows.reserve(n + table.neighbours.size());
+    columns.reserve(n + table.neighbours.size());
+    values.reserve(n + table.neighbours.size());
+    rhsU.assign(n, 0.0);
+    rhsV.assign(n, 0.0);
+
+    for (VertexId i = 0; i < n; i++) {
+        double degree = 0.0;
+        for (unsigned int entry = table.offsets[i]; entry < table.offsets[i + 1]; entry++) {
+            degree += table.weight(entry);
+        }
+
+        rows.push_back(i);
+        columns.push_back(i);
+        values.push_back(degree);
+
+        for (unsigned int entry = table.offsets[i]; entry < table.offsets[i + 1]; entry++) {
+            const VertexId neighbour = table.neighbours[entry];
+            const double weight = table.weight(entry);
+
+            if (neighbour < b) {
+                rhsU[i] += weight * textureCoords[neighbour].x;
+                rhsV[i] += weight * textureCoords[neighbour].y;
+            } else {
+                rows.push_back(i);
+                columns.push_back(neighbour - b);
+                values.push_back(-weight);
+            }
+        }
+    }
+
+    matrix = SparseMatrix(n, rows, columns, values);
+}
+
+bool TriangleMesh::solveFloaterSystem(
+    LinearSolver& solver,
+    const NeighbourTable& table,
+    UnwrapMonitor& monitor,
+    UnwrapReport& report
+) {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+
+    SparseMatrix matrix;
+    std::vector<double> rhsU;
+    std::vector<double> rhsV;
+    assembleFloaterSystem(table, matrix, rhsU, rhsV);
+
+    if (!solver.setup(matrix)) {
+        return false;
+    }
+
+    // Start from the current guess, the centre of the texture
+    std::vector<double> u(n);
+    std::vector<double> v(n);
+    for (VertexId i = 0; i < n; i++) {
+        u[i] = textureCoords[b + i].x;
+        v[i] = textureCoords[b + i].y;
+    }
+
+    // Iterations count on from the u solve into the v solve, as far as progress is concerned
+    unsigned int solvedIterations = 0;
+    solver.checkpoint = [&](const unsigned int iterations, const double relativeResidual) {
+        return monitor.checkpoint(solvedIterations + iterations, static_cast<float>(relativeResidual));
+    };
+
+    const LinearSolveReport uReport = solver.solve(rhsU, u);
+    solvedIterations = uReport.iterations;
+    LinearSolveReport vReport;
+    if (monitor.checkpoint(solvedIterations, static_cast<float>(uReport.relativeResidual))) {
+        // Stopped during the u solve, v stays at its initial guess
+        vReport.relativeResidual = relativeResidual(matrix, rhsV, v);
+    } else {
+        vReport = solver.solve(rhsV, v);
+    }
+
+    for (VertexId i = 0; i < n; i++) {
+        textureCoords[b + i] = Cartesian3(static_cast<float>(u[i]), static_cast<float>(v[i]), 0.0f);
+    }
+
+    report.iterations = std::max(uReport.iterations, vReport.iterations);
+    report.residual = static_cast<float>(std::max(uReport.relativeResidual, vReport.relativeResidual));
+    report.converged = uReport.converged && vReport.converged;
+
+    return true;
 }
 
 void TriangleMesh::computeNormals() {
@@ -346,28 +2217,141 @@ void TriangleMesh::writeToObjFile(std::ostream& objFile) const {
 }
 
 bool TriangleMesh::isBoundaryEdge(const EdgeId edgeId) const {
-    return boundary.find(edgeId) != boundary.end();
+    return edgeFlags[edgeId] & BOUNDARY_FLAG;
 }
 
 bool TriangleMesh::isBoundaryFace(const FaceIndex faceIndex) const {
-    return isBoundaryEdge(faceIndex) ||
-           isBoundaryEdge(faceIndex + 1) ||
-           isBoundaryEdge(faceIndex + 2);
+    return faceFlags[faceIndex / 3] & BOUNDARY_FLAG;
 }
 
 bool TriangleMesh::isBoundaryVertex(const VertexId vertexId) const {
-    return boundaryVerticesLookup.find(vertexId) != boundaryVerticesLookup.end();
+    return vertexFlags[vertexId] & BOUNDARY_FLAG;
+}
+
+bool TriangleMesh::isPinnedVertex(const VertexId vertexId) const {
+    return vertexFlags[vertexId] & PINNED_FLAG;
 }
 
-std::vector<unsigned int> TriangleMesh::interiorNeighbourhoodOf(const VertexId interiorVertexId) const {
-    std::vector<unsigned int> neighbourhood;
+unsigned int TriangleMesh::interiorNeighbourhoodOf(const VertexId interiorVertexId, VertexId* neighbourhood) const {
+    unsigned int count = 0;
+    const auto collect = [&](const VertexId neighbour) {
+        if (neighbourhood != nullptr) {
+            neighbourhood[count] = neighbour;
+        }
+        count++;
+    };
+
+    // Rewind to the first edge of the fan, which only exists if the fan is open (the vertex is on a hole)
+    // Closed fans come back to firstEdge and are walked from there
     const EdgeId firstEdge = firstDirectedEdge[interiorVertexId];
-    EdgeId currentEdge = firstEdge;
+    EdgeId startEdge = firstEdge;
+    while (otherHalf[PREVIOUS_EDGE(startEdge)] != NO_SUCH_ELEMENT) {
+        startEdge = otherHalf[PREVIOUS_EDGE(startEdge)];
+        if (startEdge == firstEdge) {
+            break;
+        }
+    }
+
+    // An open fan also reaches the far end of the boundary edge coming in, which no outgoing edge points to
+    if (otherHalf[PREVIOUS_EDGE(startEdge)] == NO_SUCH_ELEMENT) {
+        collect(faceVertices[NEXT_EDGE(startEdge)]);
+    }
 
+    EdgeId currentEdge = startEdge;
     do {
-        neighbourhood.push_back(faceVertices[currentEdge]);
+        collect(faceVertices[currentEdge]);
+        if (otherHalf[currentEdge] == NO_SUCH_ELEMENT) {
+            break;
+        }
         currentEdge = NEXT_EDGE(otherHalf[currentEdge]);
-    } while (otherHalf[currentEdge] != NO_SUCH_ELEMENT && currentEdge != firstEdge);
+    } while (currentEdge != startEdge);
+
+    return count;
+}
+
+bool TriangleMesh::hasOpenFan(const VertexId vertexId) const {
+    const EdgeId firstEdge = firstDirectedEdge[vertexId];
+    EdgeId edge = firstEdge;
+    do {
+        if (otherHalf[PREVIOUS_EDGE(edge)] == NO_SUCH_ELEMENT) {
+            return true;
+        }
+        edge = otherHalf[PREVIOUS_EDGE(edge)];
+    } while (edge != firstEdge);
+
+    return false;
+}
+
+NeighbourTable TriangleMesh::interiorNeighbourTable(const VertexId b, const unsigned int nThreads) const {
+    const VertexId n = vertices.size() - b;
+    NeighbourTable table;
+    table.firstInterior = b;
+    table.offsets.assign(n + 1, 0);
+    table.inverseWeightSum.resize(n);
+
+    // Two walks around every fan: the first counts, the second fills the slots the prefix sum reserved
+    parallelFor(0, n, [&](const VertexId begin, const VertexId end) {
+        for (VertexId i = begin; i < end; i++) {
+            const unsigned int degree = interiorNeighbourhoodOf(b + i, nullptr);
+            table.offsets[i + 1] = degree;
+            table.inverseWeightSum[i] = 1.0f / degree;
+        }
+    }, nThreads);
+
+    for (VertexId i = 0; i < n; i++) {
+        table.offsets[i + 1] += table.offsets[i];
+    }
+
+    table.neighbours.resize(table.offsets[n]);
+    parallelFor(0, n, [&](const VertexId begin, const VertexId end) {
+        for (VertexId i = begin; i < end; i++) {
+            interiorNeighbourhoodOf(b + i, table.neighbours.data() + table.offsets[i]);
+        }
+    }, nThreads);
 
-    return neighbourhood;
+    return table;
+}
+
+void TriangleMesh::assignMeanValueWeights(NeighbourTable& table, const unsigned int nThreads) const {
+    const VertexId b = table.firstInterior;
+    const VertexId n = table.interiorCount();
+    table.weights.resize(table.neighbours.size());
+
+    // Rows only write their own entries, and only read positions, so they are weighted in parallel
+    parallelFor(0, n, [&](const VertexId begin, const VertexId end) {
+        std::vector<double> tanHalfAngles;
+
+        for (VertexId i = begin; i < end; i++) {
+            const unsigned int first = table.offsets[i];
+            const unsigned int degree = table.offsets[i + 1] - first;
+            const Cartesian3& centre = vertices[b + i];
+
+            // tan(a / 2) = |e0 x e1| / (|e0| |e1| + e0 . e1) for the angle a between consecutive spokes e0, e1
+            // A closed fan's last spoke is followed by its first. An open fan (on a hole, or at a non-manifold
+            // vertex) has no triangle between them, that angle counts as 0 for both end spokes
+            const bool open = hasOpenFan(b + i);
+            tanHalfAngles.assign(degree, 0.0);
+            for (unsigned int k = 0; k < (open ? degree - 1 : degree); k++) {
+                const Cartesian3 spoke = vertices[table.neighbours[first + k]] - centre;
+                const Cartesian3 nextSpoke = vertices[table.neighbours[first + (k + 1) % degree]] - centre;
+                const double denominator = static_cast<double>(spoke.length()) * nextSpoke.length() + spoke.dot(nextSpoke);
+                tanHalfAngles[k] = spoke.cross(nextSpoke).length() / denominator;
+            }
+
+            double weightSum = 0.0;
+            for (unsigned int k = 0; k < degree; k++) {
+                const double length = (vertices[table.neighbours[first + k]] - centre).length();
+                const double weight = (tanHalfAngles[(k + degree - 1) % degree] + tanHalfAngles[k]) / length;
+                table.weights[first + k] = static_cast<float>(weight);
+                weightSum += table.weights[first + k];
+            }
+
+            // Coincident vertices or flat angles leave infinities or NaNs behind, fall back to the uniform average
+            if (!std::isfinite(weightSum) || !(weightSum > 0.0)) {
+                std::fill(table.weights.begin() + first, table.weights.begin() + first + degree, 1.0f);
+                weightSum = degree;
+            }
+            table.inverseWeightSum[i] = static_cast<float>(1.0 / weightSum);
+        }
+    }, nThreads);
 }
@@ -1,16 +1,30 @@
 #ifndef TRIANGLE_MESH
 #define TRIANGLE_MESH
 
-#include <unordered_set>
 #include <vector>
 #include <iostream>
+#include <memory>
+#include <string>
 
 #include "Cartesian3.h"
+#include "NeighbourTable.h"
+#include "SparseMatrix.h"
+#include "UnwrapParameters.h"
+
+// Topology flags, kept one byte per edge, vertex and face
+// Edges and vertices of any boundary loop, and faces with an edge on one
+#define BOUNDARY_FLAG 0x1
+// Vertices of the outer boundary loop, pinned onto the unit square by Floater's
+#define PINNED_FLAG 0x2
 
 typedef unsigned int VertexId;
 typedef unsigned int EdgeId;
 typedef unsigned int FaceIndex;
 
+class LinearSolver;
+class SweepAccelerator;
+class UnwrapMonitor;
+
 class TriangleMesh {
 public:
     std::vector<Cartesian3> vertices;
@@ -22,45 +36,229 @@ public:
     std::vector<VertexId> faceVertices;
     std::vector<EdgeId> firstDirectedEdge;
     std::vector<EdgeId> otherHalf;
+    // OBJ group (g or o line) of every face, numbered in order of appearance, 0 before the first one
+    std::vector<unsigned int> faceGroups;
+    // After an unwrap, chart c owns vertices [chartOffsets[c], chartOffsets[c + 1]) and their textureCoords
+    std::vector<VertexId> chartOffsets;
 
     Cartesian3 centreOfGravity;
     float objectSize;
 
-    std::unordered_set<EdgeId> boundary;
+    // Flags of every edge, vertex and face, filled in by computeBoundary
+    // Vertex flags move with the vertices when unwrap relabels them
+    std::vector<unsigned char> edgeFlags;
+    std::vector<unsigned char> vertexFlags;
+    std::vector<unsigned char> faceFlags;
+    // Every boundary loop: loop l is boundaryLoopEdges[boundaryLoopOffsets[l]..boundaryLoopOffsets[l + 1]),
+    // in walking order, and runs boundaryLoopPerimeters[l] along the surface
+    std::vector<EdgeId> boundaryLoopOffsets;
+    std::vector<EdgeId> boundaryLoopEdges;
+    std::vector<float> boundaryLoopPerimeters;
+    // Loop with the longest perimeter, mapped onto the unit square. The others are holes
+    unsigned int outerLoop;
+    // Vertices of the outer loop, in loop order
     std::vector<VertexId> boundaryVertices;
-    // Redundantly contains all of the boundaryVertices for O(1) lookup
-    std::unordered_set<VertexId> boundaryVerticesLookup;
 
     TriangleMesh();
 
+    // Loads v, vc, vn, vt, f, g and o lines, then builds the topology and cuts the mesh open into a disk
+    // The file is memory-mapped and parsed in place, in runs of whole lines on every hardware thread
+    // Polygons are split into triangles
+    // Returns false if the file cannot be read or a face refers to a missing vertex
+    bool readFromObjFile(const std::string& path);
+
+    // As above, from a stream read to its end first
     bool readFromObjFile(std::istream& objFile);
 
     // Run Floater's Algorithm to generate textureCoords
-    void unwrap();
+    // The mesh is split into charts as parameters.charts asks, every chart is unwrapped onto the unit square and
+    // the charts are then packed into one atlas. Vertices are relabelled chart by chart, see chartOffsets
+    // Relaxes until the UVs settle within parameters.tolerance or parameters.maxIterations is hit,
+    // or until parameters.cancellation or parameters.timeLimit stop it early with the UVs reached so far
+    UnwrapReport unwrap(const UnwrapParameters& parameters = UnwrapParameters());
 
     void writeToObjFile(std::ostream& objFile) const;
 
     // Returns true if any of its edges are boundary
+    // faceIndex is the position of the face's first vertex in faceVertices
     bool isBoundaryFace(FaceIndex faceIndex) const;
 
 private:
+    // Parses the OBJ text [begin, end) into the mesh, see readFromObjFile
+    // Every chunk of the text is parsed into buffers of its own, which are then concatenated in order
+    bool readFromObjText(const char* begin, const char* end);
+
     void computeCentreOfGravity();
 
     void computeHalfEdge();
 
     void computeBoundary();
 
+    // Extracts every boundary loop, with its perimeter, and picks the outer one, in a single pass over the edges
+    void computeBoundaryLoops();
+
+    // Closes every hole (boundary loop other than the outer one) with a fan of triangles around a new vertex at
+    // its centre. Vertices and faces are appended, the half-edge structure is left to recompute
+    void fillHoles();
+
+    // Cuts every closed and higher-genus connected component open into a disk, along seams that are kept short
+    // Seams are a shortest-path tree from the longest boundary loop of the component (or a vertex of closed ones)
+    // plus the 2g edges off a dual spanning tree, pruned of dead ends. Vertices along them are split in two or more
+    // Disks, also ones with further holes, are left as they are
+    void cutToDisk(std::ostream& log);
+
     void computeNormals();
 
-    // Returns true if edgeId is registered as boundary
+    // Returns true if edgeId is on a boundary loop
     bool isBoundaryEdge(EdgeId edgeId) const;
 
-    // Returns true if any of its incident edges are boundary, or if it's not connected
+    // Returns true if vertexId is on a boundary loop
     bool isBoundaryVertex(VertexId vertexId) const;
 
-    // Returns a vector containing all the neighbouring vertices of vertexId
-    // Assumes the vertex is interior (ie: non-boundary)
-    std::vector<VertexId> interiorNeighbourhoodOf(VertexId interiorVertexId) const;
+    // Returns true if vertexId is on the outer boundary loop, which is pinned onto the unit square
+    bool isPinnedVertex(VertexId vertexId) const;
+
+    // Numbers the charts of mode into faceCharts, one per face, and returns how many there are
+    unsigned int labelCharts(ChartMode mode, std::vector<unsigned int>& faceCharts) const;
+
+    // Copies every chart into a mesh of its own, vertices shared by several charts are copied into each
+    // Only positions, colours, normals and groups are carried over, the half-edge structure is left to build
+    // chartVertices[c][v] is the vertex of this mesh that vertex v of chart c is a copy of
+    std::vector<TriangleMesh> splitCharts(
+        const std::vector<unsigned int>& faceCharts,
+        unsigned int chartCount,
+        std::vector<std::vector<VertexId>>& chartVertices
+    ) const;
+
+    // Unwraps the whole mesh as one chart, mapping its boundary loop onto the unit square
+    UnwrapReport unwrapChart(const UnwrapParameters& parameters, UnwrapMonitor& monitor);
+
+    // Unwraps every chart of faceCharts on its own, on a pool of parameters.threads threads, and packs the
+    // results into one atlas. The mesh is replaced by its charts, one after another
+    UnwrapReport unwrapCharts(
+        const std::vector<unsigned int>& faceCharts,
+        unsigned int chartCount,
+        const UnwrapParameters& parameters,
+        UnwrapMonitor& monitor
+    );
+
+    // Moves old vertex order[v] to v in every per-vertex array and in faceVertices
+    // Vertices missing from order (unconnected ones) are dropped
+    void relabelVertices(const std::vector<VertexId>& order);
+
+    // Locality order of the interior vertices [b..vertices.size()) requested by parameters.ordering
+    // Returns order such that vertex b + order[k] becomes vertex b + k
+    std::vector<VertexId> interiorOrdering(VertexId b, const UnwrapParameters& parameters) const;
+
+    // Writes the neighbouring vertices of interiorVertexId to neighbourhood, unless it is null
+    // Returns how many there are. The vertex must not be pinned, but it may sit on a hole (an open fan)
+    unsigned int interiorNeighbourhoodOf(VertexId interiorVertexId, VertexId* neighbourhood) const;
+
+    // Whether the triangles around vertexId stop at a boundary edge rather than coming full circle
+    // interiorNeighbourhoodOf then lists the neighbours from one end of the fan to the other
+    bool hasOpenFan(VertexId vertexId) const;
+
+    // Adjacency of the interior vertices [b..vertices.size()), walked straight off the half-edge arrays
+    NeighbourTable interiorNeighbourTable(VertexId b, unsigned int nThreads) const;
+
+    // Fills in Floater's mean-value weights of table from the vertex positions, one row per task
+    // w_ij = (tan(a_ij / 2) + tan(b_ij / 2)) / |x_j - x_i|, where a_ij and b_ij are the angles at x_i of the
+    // two triangles on edge ij. Rows with degenerate triangles keep uniform weights
+    void assignMeanValueWeights(NeighbourTable& table, unsigned int nThreads) const;
+
+    // Floater's averaging sweeps over the interior vertices of table
+    UnwrapReport relaxFloater(
+        const NeighbourTable& table,
+        const UnwrapParameters& parameters,
+        UnwrapMonitor& monitor
+    );
+
+    // Floater's sweeps with successive over-relaxation
+    // The factor starts at 1 and is re-estimated every few sweeps from the observed convergence rate
+    UnwrapReport relaxFloaterOverRelaxed(
+        const NeighbourTable& table,
+        const UnwrapParameters& parameters,
+        UnwrapMonitor& monitor
+    );
+
+    // Floater's sweeps over contiguous tiles of interior vertices, several per tile while it is in cache
+    // Converges to the same UVs as relaxFloater, the iteration count is in passes over all tiles
+    UnwrapReport relaxFloaterBlocked(
+        const NeighbourTable& table,
+        const UnwrapParameters& parameters,
+        UnwrapMonitor& monitor
+    );
+
+    // Floater's sweeps with the interior vertices split into colour classes
+    // Classes are relaxed one after another, the vertices of a class in parallel
+    // The result does not depend on the number of threads
+    UnwrapReport relaxFloaterColoured(
+        const NeighbourTable& table,
+        const UnwrapParameters& parameters,
+        UnwrapMonitor& monitor
+    );
+
+    // Chaotic relaxation: every thread sweeps its own contiguous partition of interior vertices
+    // over and over, reading neighbour UVs through relaxed atomics and never waiting for the others
+    // Stops once every thread's latest sweep moved less than parameters.tolerance
+    UnwrapReport relaxFloaterAsynchronous(
+        const NeighbourTable& table,
+        const UnwrapParameters& parameters,
+        UnwrapMonitor& monitor
+    );
+
+    // Residual-driven relaxation: only vertices whose neighbours moved by at least parameters.tolerance
+    // (summed since they were last relaxed) are relaxed again, largest moves first
+    // Threads own a bucket queue each and steal from the others once theirs is empty
+    UnwrapReport relaxFloaterWorklist(
+        const NeighbourTable& table,
+        const UnwrapParameters& parameters,
+        UnwrapMonitor& monitor
+    );
+
+    // Iterative refinement of the relaxed UVs: residuals are evaluated and corrections added in double,
+    // corrections are relaxed in float, until the residual falls below parameters.tolerance or stops shrinking
+    // Sweeps count towards report.iterations, which also receives the final residual
+    void refineFloater(
+        const NeighbourTable& table,
+        const UnwrapParameters& parameters,
+        UnwrapMonitor& monitor,
+        UnwrapReport& report
+    );
+
+    // Accelerator requested by parameters.acceleration, started on the UVs of [begin, end), or nullptr
+    std::unique_ptr<SweepAccelerator> startSweepAccelerator(
+        VertexId begin,
+        VertexId end,
+        const std::vector<float>& u,
+        const std::vector<float>& v,
+        const UnwrapParameters& parameters
+    ) const;
+
+    // Copies the UVs of textureCoords into separate u and v arrays, as used by the relaxation kernels
+    void splitTextureCoords(std::vector<float>& u, std::vector<float>& v) const;
+
+    // Writes u and v back into textureCoords, from vertex b onwards
+    void mergeTextureCoords(VertexId b, const std::vector<float>& u, const std::vector<float>& v);
+
+    // Times the original Cartesian3 sweep against the flat scalar and vector kernels, without touching the UVs
+    void benchmarkRelaxation(const NeighbourTable& table) const;
+
+    // Builds the interior system of Floater's, boundary UVs are moved to the right-hand sides
+    void assembleFloaterSystem(
+        const NeighbourTable& table,
+        SparseMatrix& matrix,
+        std::vector<double>& rhsU,
+        std::vector<double>& rhsV
+    ) const;
+
+    // Solves the assembled interior system with solver, returns false if the solver could not be set up
+    bool solveFloaterSystem(
+        LinearSolver& solver,
+        const NeighbourTable& table,
+        UnwrapMonitor& monitor,
+        UnwrapReport& report
+    );
 };
 
 #endif
@@ -0,0 +1,33 @@
+#include "UnionFind.h"
+
+#include <numeric>
+#include <utility>
+
+UnionFind::UnionFind(const unsigned int count)
+    : parent(count),
+      size(count, 1) {
+    std::iota(parent.begin(), parent.end(), 0u);
+}
+
+unsigned int UnionFind::find(unsigned int element) {
+    while (parent[element] != element) {
+        parent[element] = parent[parent[element]];
+        element = parent[element];
+    }
+    return element;
+}
+
+bool UnionFind::unite(unsigned int a, unsigned int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return false;
+    }
+
+    if (size[a] < size[b]) {
+        std::swap(a, b);
+    }
+    parent[b] = a;
+    size[a] += size[b];
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <vector>
+
+// Disjoint sets over [0, count), merged by size and flattened by path halving
+// Any sequence of finds and unions runs in near-linear time
+class UnionFind {
+    std::vector<unsigned int> parent;
+    std::vector<unsigned int> size;
+
+public:
+    explicit UnionFind(unsigned int count);
+
+    // Representative of the set holding element
+    unsigned int find(unsigned int element);
+
+    // Merges the sets holding a and b, returns false if they were one already
+    bool unite(unsigned int a, unsigned int b);
+};
+
+#endif
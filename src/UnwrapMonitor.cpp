@@ -0,0 +1,75 @@
+#include "UnwrapMonitor.h"
+
+#include <algorithm>
+
+UnwrapMonitor::UnwrapMonitor(const UnwrapParameters& parameters)
+    : parameters(parameters),
+      start(std::chrono::steady_clock::now()),
+      timed(parameters.progress || parameters.timeLimit > 0.0f || parameters.snapshots),
+      nextProgress(start + std::chrono::milliseconds(PROGRESS_INTERVAL_MS)),
+      lastClock(start),
+      clockStride(1),
+      checkpointsToClock(1),
+      snapshotDue(false),
+      cancelled(false),
+      timedOut(false) {
+}
+
+bool UnwrapMonitor::checkpoint(const unsigned int iterations, const float residual) {
+    if (parameters.cancellation && parameters.cancellation->isCancelled()) {
+        cancelled = true;
+    }
+
+    if (timed && --checkpointsToClock == 0) {
+        readClock(iterations, residual);
+    }
+
+    return stopped();
+}
+
+void UnwrapMonitor::readClock(const unsigned int iterations, const float residual) {
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsedSeconds = std::chrono::duration<double>(now - start).count();
+
+    // Aim the next read CLOCK_INTERVAL_US ahead, going by the checkpoints since the last one
+    // The stride at most doubles per read, so a slow first sweep or a fast patch cannot throw it far off
+    const double checkpointMicroseconds =
+        std::chrono::duration<double, std::micro>(now - lastClock).count() / clockStride;
+    const double growth = std::min(2.0 * clockStride, static_cast<double>(MAX_CLOCK_STRIDE));
+    const double stride = checkpointMicroseconds > 0.0 ? CLOCK_INTERVAL_US / checkpointMicroseconds : growth;
+    clockStride = static_cast<unsigned int>(std::clamp(stride, 1.0, growth));
+    checkpointsToClock = clockStride;
+    lastClock = now;
+
+    if (parameters.timeLimit > 0.0f && elapsedSeconds >= parameters.timeLimit) {
+        timedOut = true;
+    }
+
+    if (parameters.progress && now >= nextProgress) {
+        nextProgress = now + std::chrono::milliseconds(PROGRESS_INTERVAL_MS);
+        parameters.progress(UnwrapProgress(iterations, residual, elapsedSeconds));
+    }
+
+    if (parameters.snapshots && parameters.snapshots->due(now)) {
+        snapshotDue = true;
+    }
+}
+
+bool UnwrapMonitor::stopped() const {
+    return cancelled || timedOut;
+}
+
+double UnwrapMonitor::elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void UnwrapMonitor::finish(UnwrapReport& report) {
+    report.cancelled = cancelled;
+    report.timedOut = timedOut;
+    report.elapsedSeconds = elapsedSeconds();
+
+    if (parameters.progress) {
+        const float residual = report.residual > 0.0f ? report.residual : report.maxDisplacement;
+        parameters.progress(UnwrapProgress(report.iterations, residual, report.elapsedSeconds));
+    }
+}
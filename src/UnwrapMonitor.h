@@ -0,0 +1,76 @@
+#ifndef UNWRAP_MONITOR_H
+#define UNWRAP_MONITOR_H
+
+#include <chrono>
+
+#include "Cartesian3.h"
+#include "UnwrapParameters.h"
+#include "UvSnapshotBuffer.h"
+
+// Least time between two progress callbacks
+#define PROGRESS_INTERVAL_MS 500
+
+// Time aimed for between two reads of the clock, which bounds how late the time limit and snapshots can be
+#define CLOCK_INTERVAL_US 1000
+// Most checkpoints between two reads of the clock, however fast checkpoints come
+#define MAX_CLOCK_STRIDE (1u << 16)
+
+// Watches a single unwrap for its caller: reports progress, publishes UV snapshots, and tells the solver
+// loops when to give up because of cancellation or the time limit
+// Loops call checkpoint once per sweep (or iteration), always from the same thread
+// Cancellation is one relaxed load per checkpoint. A callback, time limit or snapshot buffer needs the clock too,
+// which is only read every clockStride checkpoints, the stride following how long checkpoints take
+class UnwrapMonitor {
+    const UnwrapParameters& parameters;
+    const std::chrono::steady_clock::time_point start;
+    // Whether checkpoints need the clock at all
+    const bool timed;
+    std::chrono::steady_clock::time_point nextProgress;
+    std::chrono::steady_clock::time_point lastClock;
+    unsigned int clockStride;
+    unsigned int checkpointsToClock;
+    // Set by the checkpoint that found a snapshot due, until one is published
+    bool snapshotDue;
+    bool cancelled;
+    bool timedOut;
+
+    // Checks the time limit, the progress callback and the snapshots, and sets the stride to the next read
+    void readClock(unsigned int iterations, float residual);
+
+public:
+    explicit UnwrapMonitor(const UnwrapParameters& parameters);
+
+    // Returns true if the solve should stop now, and from then on
+    // residual is the largest UV displacement of the last sweep, or the relative residual of assembled solvers
+    bool checkpoint(unsigned int iterations, float residual);
+
+    // checkpoint that also publishes u and v (indexed by vertex) when a snapshot is due
+    template <typename Array>
+    bool checkpoint(unsigned int iterations, float residual, const Array& u, const Array& v);
+
+    // Whether a checkpoint has asked the solve to stop
+    bool stopped() const;
+
+    // Time since the unwrap started, safe to read from any thread
+    double elapsedSeconds() const;
+
+    // Records how the solve ended in report, and hands it to the progress callback one last time
+    void finish(UnwrapReport& report);
+};
+
+template <typename Array>
+bool UnwrapMonitor::checkpoint(const unsigned int iterations, const float residual, const Array& u, const Array& v) {
+    const bool stop = checkpoint(iterations, residual);
+
+    // Also picks up snapshots found due by checkpoints without UVs
+    if (snapshotDue) {
+        snapshotDue = false;
+        parameters.snapshots->publish([&](const unsigned int vertex) {
+            return Cartesian3(static_cast<float>(u[vertex]), static_cast<float>(v[vertex]), 0.0f);
+        });
+    }
+
+    return stop;
+}
+
+#endif
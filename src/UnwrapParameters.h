@@ -0,0 +1,204 @@
+#ifndef UNWRAP_PARAMETERS_H
+#define UNWRAP_PARAMETERS_H
+
+#include <atomic>
+#include <functional>
+
+// Defaults for the relaxation loop
+#define DEFAULT_TOLERANCE 1e-6f
+#define DEFAULT_MAX_ITERATIONS 100000
+
+class UvSnapshotBuffer;
+
+// How far a solve has got, handed to UnwrapParameters::progress
+class UnwrapProgress {
+public:
+    // Sweeps, or solver iterations, so far
+    unsigned int iterations;
+    // Largest UV displacement of the last sweep, or the relative residual of the assembled solvers
+    float residual;
+    double elapsedSeconds;
+
+    UnwrapProgress(const unsigned int iterations, const float residual, const double elapsedSeconds)
+        : iterations(iterations),
+          residual(residual),
+          elapsedSeconds(elapsedSeconds) {
+    }
+};
+
+// Lets any thread ask a running unwrap to stop, the solver loops check it between sweeps
+class CancellationToken {
+    std::atomic<bool> cancelled;
+
+public:
+    CancellationToken()
+        : cancelled(false) {
+    }
+
+    void cancel() {
+        cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    bool isCancelled() const {
+        return cancelled.load(std::memory_order_relaxed);
+    }
+};
+
+// How the interior UVs are computed
+enum class SolverMode {
+    // In-place averaging sweeps (Gauss-Seidel) over the implicit system
+    Relaxation,
+    // Gauss-Seidel sweeps over-relaxed by a factor estimated from the observed convergence rate
+    OverRelaxation,
+    // Gauss-Seidel sweeps over graph colour classes, each class relaxed in parallel
+    ParallelRelaxation,
+    // Gauss-Seidel sweeps repeated over cache-sized tiles of interior vertices before moving on
+    BlockedRelaxation,
+    // Threads relax their own vertex partitions continuously, without synchronising sweeps
+    AsynchronousRelaxation,
+    // Only vertices whose neighbourhood moved are relaxed again, from per-thread priority worklists
+    WorklistRelaxation,
+    // Assembled sparse system, factorised once and solved for u and v
+    Direct,
+    // Assembled sparse system, solved by preconditioned conjugate gradient
+    ConjugateGradient,
+    // Assembled sparse system, solved by algebraic multigrid V-cycles
+    Multigrid
+};
+
+// Preconditioner used by SolverMode::ConjugateGradient
+enum class PreconditionerMode {
+    Jacobi,
+    IncompleteCholesky,
+    // A single algebraic multigrid V-cycle
+    Multigrid
+};
+
+// Extrapolation wrapped around the relaxation sweeps of SolverMode::Relaxation and ParallelRelaxation
+enum class AccelerationMode {
+    None,
+    // Chebyshev semi-iteration with an estimated spectral radius
+    Chebyshev,
+    // Anderson mixing over the last few iterates
+    Anderson
+};
+
+// Weights of the neighbours in the average every interior vertex relaxes to
+enum class WeightMode {
+    // Every neighbour weighs 1, Tutte's barycentric embedding
+    Uniform,
+    // Floater's mean-value weights, which preserve the shape of the one-rings
+    MeanValue
+};
+
+// Order given to the interior vertices when they are relabelled for Floater's
+enum class VertexOrdering {
+    // Input order
+    None,
+    // Reverse Cuthill-McKee over the interior adjacency
+    ReverseCuthillMcKee,
+    // Z-order curve over the 3D positions
+    Morton,
+    // Hilbert curve over the 3D positions
+    Hilbert
+};
+
+// Arithmetic of the relaxation modes
+enum class PrecisionMode {
+    // Sweeps over float UVs until the tolerance is met
+    Single,
+    // Float sweeps down to float round-off, then iterative refinement of the residual in double
+    Mixed
+};
+
+// How the mesh is split into charts, every chart is unwrapped onto its own square of the texture atlas
+enum class ChartMode {
+    // The whole mesh is a single chart, mapped onto the entire unit square
+    Single,
+    // Every edge-connected component is a chart
+    Components,
+    // Every edge-connected component of every OBJ group (g or o lines) is a chart
+    Groups
+};
+
+class UnwrapParameters {
+public:
+    SolverMode solver;
+    PreconditionerMode preconditioner;
+    AccelerationMode acceleration;
+    WeightMode weights;
+    VertexOrdering ordering;
+    PrecisionMode precision;
+    ChartMode charts;
+    // Relaxation stops once the largest UV displacement of a sweep falls below this
+    // Iterative linear solvers stop once the relative residual falls below this
+    float tolerance;
+    // Hard cap on the number of sweeps (or solver iterations), regardless of convergence
+    unsigned int maxIterations;
+    // Wall-clock budget of the unwrap in seconds, 0 for none. Solvers stop at their first check past it
+    float timeLimit;
+    // Worker threads for parallel modes, 0 uses every hardware thread
+    unsigned int threads;
+    // Time the relaxation kernels against each other before solving
+    bool benchmarkKernels;
+    // Print the progress messages of every stage, charts of a multi-chart unwrap are solved quietly
+    bool verbose;
+    // Receives the UVs every now and then while relaxing, if set, for a viewer to follow the solve
+    // Multi-chart unwraps publish the largest chart only, in its square of the atlas, the others appear at the end
+    UvSnapshotBuffer* snapshots;
+    // Called from the solving thread every PROGRESS_INTERVAL_MS, and once more when the solve ends, if set
+    std::function<void(const UnwrapProgress&)> progress;
+    // Stops the solve early once cancelled, if set
+    const CancellationToken* cancellation;
+
+    UnwrapParameters()
+        : solver(SolverMode::Relaxation),
+          preconditioner(PreconditionerMode::IncompleteCholesky),
+          acceleration(AccelerationMode::None),
+          weights(WeightMode::MeanValue),
+          ordering(VertexOrdering::None),
+          precision(PrecisionMode::Single),
+          charts(ChartMode::Components),
+          tolerance(DEFAULT_TOLERANCE),
+          maxIterations(DEFAULT_MAX_ITERATIONS),
+          timeLimit(0.0f),
+          threads(0),
+          benchmarkKernels(false),
+          verbose(true),
+          snapshots(nullptr),
+          cancellation(nullptr) {
+    }
+};
+
+// Summary of how the solve ended, filled in by TriangleMesh::unwrap
+class UnwrapReport {
+public:
+    unsigned int iterations;
+    // Largest and root-mean-square UV displacement of the last sweep
+    float maxDisplacement;
+    float rmsDisplacement;
+    // Largest relative residual of the u and v systems, only set by assembled solvers
+    float residual;
+    // Largest residual of the averaging equations, evaluated in double, only set by PrecisionMode::Mixed
+    double refinedResidual;
+    bool converged;
+    // Why an unconverged solve stopped before its iteration cap
+    bool cancelled;
+    bool timedOut;
+    // Wall-clock time of the whole unwrap, relabelling and setup included
+    double elapsedSeconds;
+
+    UnwrapReport()
+        : iterations(0),
+          maxDisplacement(0.0f),
+          rmsDisplacement(0.0f),
+          residual(0.0f),
+          refinedResidual(0.0),
+          converged(false),
+          cancelled(false),
+          timedOut(false),
+          elapsedSeconds(0.0) {
+    }
+};
+
+#endif
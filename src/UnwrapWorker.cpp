@@ -0,0 +1,43 @@
+#include "UnwrapWorker.h"
+
+#include <iostream>
+
+UnwrapWorker::UnwrapWorker(const TriangleMesh& mesh, const UnwrapParameters& parameters)
+    : mesh(mesh),
+      parameters(parameters),
+      done(false),
+      snapshots(mesh.vertices.size()) {
+    this->parameters.snapshots = &snapshots;
+    this->parameters.cancellation = &cancellation;
+
+    thread = std::thread([this] {
+        report = this->mesh.unwrap(this->parameters);
+        done.store(true, std::memory_order_release);
+    });
+}
+
+UnwrapWorker::~UnwrapWorker() {
+    if (thread.joinable()) {
+        if (!finished()) {
+            std::cout << "Cancelling the unwrap..." << std::endl;
+            cancel();
+        }
+        thread.join();
+    }
+}
+
+void UnwrapWorker::cancel() {
+    cancellation.cancel();
+}
+
+bool UnwrapWorker::finished() const {
+    return done.load(std::memory_order_acquire);
+}
+
+TriangleMesh UnwrapWorker::takeMesh() {
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    return std::move(mesh);
+}
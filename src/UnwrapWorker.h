@@ -0,0 +1,43 @@
+#ifndef UNWRAP_WORKER_H
+#define UNWRAP_WORKER_H
+
+#include <atomic>
+#include <thread>
+
+#include "TriangleMesh.h"
+#include "UnwrapParameters.h"
+#include "UvSnapshotBuffer.h"
+
+// Runs TriangleMesh::unwrap on a background thread, over its own copy of the mesh
+// The viewer keeps drawing the original meanwhile, following the UVs through snapshots
+class UnwrapWorker {
+    TriangleMesh mesh;
+    UnwrapParameters parameters;
+    CancellationToken cancellation;
+    std::atomic<bool> done;
+    std::thread thread;
+
+public:
+    // Intermediate UVs, in the labelling of the mesh given to the constructor
+    UvSnapshotBuffer snapshots;
+    // How the solve ended, once finished
+    UnwrapReport report;
+
+    // Copies mesh and starts unwrapping it straight away
+    // parameters.cancellation is replaced by the worker's own token, see cancel()
+    UnwrapWorker(const TriangleMesh& mesh, const UnwrapParameters& parameters);
+
+    // Cancels the unwrap and waits for the solver to notice
+    ~UnwrapWorker();
+
+    // Asks the solver to stop at its next check, it then finishes with the UVs reached so far
+    void cancel();
+
+    bool finished() const;
+
+    // Moves the unwrapped mesh out, waiting for it if needed
+    // unwrap relabels vertices, so it replaces the original mesh rather than patching its UVs
+    TriangleMesh takeMesh();
+};
+
+#endif
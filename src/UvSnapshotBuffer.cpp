@@ -0,0 +1,49 @@
+#include "UvSnapshotBuffer.h"
+
+#include <limits>
+
+UvSnapshotBuffer::UvSnapshotBuffer(const unsigned int vertexCount)
+    : slots{std::vector<Cartesian3>(vertexCount), std::vector<Cartesian3>(vertexCount)},
+      state(0),
+      chartCorner(0.0f, 0.0f, 0.0f),
+      chartSide(1.0f),
+      lastTaken(0) {
+}
+
+void UvSnapshotBuffer::relabel(const std::vector<unsigned int>& originalVertices) {
+    this->originalVertices = originalVertices;
+
+    if (!chartVertices.empty()) {
+        for (unsigned int& vertex : this->originalVertices) {
+            // Vertices the chart added itself, such as copies along its seams, are left out
+            vertex = vertex < chartVertices.size() ? chartVertices[vertex] : std::numeric_limits<unsigned int>::max();
+        }
+    }
+}
+
+void UvSnapshotBuffer::place(const std::vector<unsigned int>& chartVertices, const Cartesian3& corner,
+                             const float side) {
+    this->chartVertices = chartVertices;
+    chartCorner = corner;
+    chartSide = side;
+}
+
+bool UvSnapshotBuffer::due(const std::chrono::steady_clock::time_point now) const {
+    return now - lastPublished >= std::chrono::milliseconds(SNAPSHOT_INTERVAL_MS);
+}
+
+bool UvSnapshotBuffer::take(std::vector<Cartesian3>& textureCoords) {
+    // Mark the front as being copied, which keeps the writer from flipping it away
+    unsigned int current = state.load(std::memory_order_acquire);
+    do {
+        if ((current >> 2) == lastTaken) {
+            return false;
+        }
+    } while (!state.compare_exchange_weak(current, current | 2u, std::memory_order_acquire));
+
+    textureCoords = slots[current & 1u];
+    lastTaken = current >> 2;
+
+    state.fetch_and(~2u, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,84 @@
+#ifndef UV_SNAPSHOT_BUFFER_H
+#define UV_SNAPSHOT_BUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "Cartesian3.h"
+
+// Least time between two snapshots, copying the UVs after every sweep would slow the solve down
+#define SNAPSHOT_INTERVAL_MS 50
+
+// Lock-free double buffer of intermediate UVs, from one writer (the solver) to one reader (the viewer)
+// The writer fills the back slot and flips it to the front, unless the reader is copying the front right then,
+// in which case that snapshot is dropped and the next one tries again. Neither side ever waits for the other
+class UvSnapshotBuffer {
+    std::vector<Cartesian3> slots[2];
+    // Bit 0: front slot, bit 1: set while the reader copies the front slot, higher bits: snapshots published
+    std::atomic<unsigned int> state;
+
+    // Writer side: vertex of the original mesh every solver vertex came from
+    std::vector<unsigned int> originalVertices;
+    // Writer side: when solving one chart of a multi-chart unwrap, the mesh vertex of every chart vertex,
+    // and the square of the atlas the chart's UVs are moved into
+    std::vector<unsigned int> chartVertices;
+    Cartesian3 chartCorner;
+    float chartSide;
+    std::chrono::steady_clock::time_point lastPublished;
+
+    // Reader side: snapshot count of the last take
+    unsigned int lastTaken;
+
+public:
+    // Snapshots cover vertexCount vertices, in the labelling of the mesh before unwrap relabelled it
+    explicit UvSnapshotBuffer(unsigned int vertexCount);
+
+    // Writer: solver vertex v is vertex originalVertices[v] of the original mesh from now on
+    // Once placed, originalVertices label the chart instead, and go through chartVertices
+    void relabel(const std::vector<unsigned int>& originalVertices);
+
+    // Writer: the solver works on a single chart from now on, chart vertex c being vertex chartVertices[c] of
+    // the original mesh, and its UVs land in the side x side square of the atlas at corner
+    // Vertices of the other charts keep whatever was published for them before
+    void place(const std::vector<unsigned int>& chartVertices, const Cartesian3& corner, float side);
+
+    // Writer: true once SNAPSHOT_INTERVAL_MS has passed since the last snapshot, now being the time of asking
+    // The clock is left to the caller, which reads it for other reasons too
+    bool due(std::chrono::steady_clock::time_point now) const;
+
+    // Writer: publishes uvOf(v) for every solver vertex v, vertices never relabelled keep UV (0, 0)
+    template <typename UvOf>
+    void publish(UvOf uvOf);
+
+    // Reader: copies the latest snapshot into textureCoords
+    // Returns false, leaving textureCoords alone, if nothing was published since the last take
+    bool take(std::vector<Cartesian3>& textureCoords);
+};
+
+template <typename UvOf>
+void UvSnapshotBuffer::publish(UvOf uvOf) {
+    lastPublished = std::chrono::steady_clock::now();
+
+    // Only the writer moves the front, so the back slot stays the back slot meanwhile
+    unsigned int current = state.load(std::memory_order_acquire);
+    const unsigned int back = (current & 1u) ^ 1u;
+
+    std::vector<Cartesian3>& slot = slots[back];
+    for (unsigned int vertex = 0; vertex < originalVertices.size(); vertex++) {
+        // Vertices added for the solve only, such as hole fillings, have no place in the snapshot
+        if (originalVertices[vertex] < slot.size()) {
+            slot[originalVertices[vertex]] = chartCorner + uvOf(vertex) * chartSide;
+        }
+    }
+
+    // Flip, unless the reader got hold of the front first
+    while (!(current & 2u)) {
+        const unsigned int published = ((current >> 2) + 1) << 2 | back;
+        if (state.compare_exchange_weak(current, published, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+#endif
@@ -1,24 +1,196 @@
 #include <iostream>
-#include <fstream>
+#include <cctype>
+#include <cmath>
 #include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
 
 #include "RenderWindow.h"
 #include "TriangleMesh.h"
 #include "RenderParameters.h"
 #include "RenderController.h"
+#include "UnwrapParameters.h"
+#include "UnwrapWorker.h"
+
+// Parses a whole count, std::stoul alone would wrap "-1" around to the largest value
+// Throws std::invalid_argument or std::out_of_range if value is not one
+unsigned int parseCount(const std::string& value) {
+    if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) {
+        throw std::invalid_argument(value);
+    }
+
+    std::size_t end;
+    const unsigned long count = std::stoul(value, &end);
+    if (end != value.size() || count > std::numeric_limits<unsigned int>::max()) {
+        throw std::out_of_range(value);
+    }
+    return static_cast<unsigned int>(count);
+}
+
+// Parses a whole finite number, std::stof alone also takes nan and inf
+// Throws std::invalid_argument or std::out_of_range if value is not one
+float parseFinite(const std::string& value) {
+    std::size_t end;
+    const float number = std::stof(value, &end);
+    if (end != value.size() || !std::isfinite(number)) {
+        throw std::invalid_argument(value);
+    }
+    return number;
+}
+
+// Parses a single --option=value argument into unwrapParameters
+// Returns false if the option is unknown or its value is malformed
+bool parseUnwrapOption(const std::string& argument, UnwrapParameters& unwrapParameters) {
+    if (argument == "--benchmark-kernels") {
+        unwrapParameters.benchmarkKernels = true;
+        return true;
+    }
+
+    const auto separator = argument.find('=');
+    if (argument.rfind("--", 0) != 0 || separator == std::string::npos) {
+        return false;
+    }
+
+    const std::string option = argument.substr(2, separator - 2);
+    const std::string value = argument.substr(separator + 1);
+
+    try {
+        if (option == "solver") {
+            if (value == "relaxation") {
+                unwrapParameters.solver = SolverMode::Relaxation;
+            } else if (value == "parallel") {
+                unwrapParameters.solver = SolverMode::ParallelRelaxation;
+            } else if (value == "sor") {
+                unwrapParameters.solver = SolverMode::OverRelaxation;
+            } else if (value == "blocked") {
+                unwrapParameters.solver = SolverMode::BlockedRelaxation;
+            } else if (value == "async") {
+                unwrapParameters.solver = SolverMode::AsynchronousRelaxation;
+            } else if (value == "worklist") {
+                unwrapParameters.solver = SolverMode::WorklistRelaxation;
+            } else if (value == "direct") {
+                unwrapParameters.solver = SolverMode::Direct;
+            } else if (value == "cg") {
+                unwrapParameters.solver = SolverMode::ConjugateGradient;
+            } else if (value == "amg") {
+                unwrapParameters.solver = SolverMode::Multigrid;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (option == "preconditioner") {
+            if (value == "jacobi") {
+                unwrapParameters.preconditioner = PreconditionerMode::Jacobi;
+            } else if (value == "ic0") {
+                unwrapParameters.preconditioner = PreconditionerMode::IncompleteCholesky;
+            } else if (value == "amg") {
+                unwrapParameters.preconditioner = PreconditionerMode::Multigrid;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (option == "acceleration") {
+            if (value == "none") {
+                unwrapParameters.acceleration = AccelerationMode::None;
+            } else if (value == "chebyshev") {
+                unwrapParameters.acceleration = AccelerationMode::Chebyshev;
+            } else if (value == "anderson") {
+                unwrapParameters.acceleration = AccelerationMode::Anderson;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (option == "weights") {
+            if (value == "uniform") {
+                unwrapParameters.weights = WeightMode::Uniform;
+            } else if (value == "mean-value") {
+                unwrapParameters.weights = WeightMode::MeanValue;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (option == "ordering") {
+            if (value == "none") {
+                unwrapParameters.ordering = VertexOrdering::None;
+            } else if (value == "rcm") {
+                unwrapParameters.ordering = VertexOrdering::ReverseCuthillMcKee;
+            } else if (value == "morton") {
+                unwrapParameters.ordering = VertexOrdering::Morton;
+            } else if (value == "hilbert") {
+                unwrapParameters.ordering = VertexOrdering::Hilbert;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (option == "precision") {
+            if (value == "single") {
+                unwrapParameters.precision = PrecisionMode::Single;
+            } else if (value == "mixed") {
+                unwrapParameters.precision = PrecisionMode::Mixed;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (option == "charts") {
+            if (value == "single") {
+                unwrapParameters.charts = ChartMode::Single;
+            } else if (value == "components") {
+                unwrapParameters.charts = ChartMode::Components;
+            } else if (value == "groups") {
+                unwrapParameters.charts = ChartMode::Groups;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (option == "tolerance") {
+            // A tolerance of 0 or less is never met, every relaxation would run to the iteration cap
+            unwrapParameters.tolerance = parseFinite(value);
+            return unwrapParameters.tolerance > 0.0f;
+        }
+        if (option == "time-limit") {
+            unwrapParameters.timeLimit = parseFinite(value);
+            return unwrapParameters.timeLimit >= 0.0f;
+        }
+        if (option == "max-iterations") {
+            unwrapParameters.maxIterations = parseCount(value);
+            return true;
+        }
+        if (option == "threads") {
+            unwrapParameters.threads = parseCount(value);
+            return true;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    return false;
+}
 
 int main(int argc, char** argv) {
     QApplication renderApp(argc, argv);
 
-    if (argc != 2) {
-        std::cout << "Usage: " << argv[0] << " <.obj>" << std::endl;
+    UnwrapParameters unwrapParameters;
+    bool validArguments = argc >= 2;
+    for (int arg = 2; arg < argc && validArguments; arg++) {
+        validArguments = parseUnwrapOption(argv[arg], unwrapParameters);
+    }
+
+    if (!validArguments) {
+        std::cout << "Usage: " << argv[0] << " <.obj> [--solver=relaxation|sor|parallel|blocked|async|worklist|direct|cg|amg] [--preconditioner=jacobi|ic0|amg] [--acceleration=none|chebyshev|anderson] [--weights=uniform|mean-value] [--ordering=none|rcm|morton|hilbert] [--precision=single|mixed] [--charts=single|components|groups] [--tolerance=<float>] [--max-iterations=<uint>] [--time-limit=<seconds>] [--threads=<uint>] [--benchmark-kernels]" << std::endl;
         return EXIT_FAILURE;
     }
 
     TriangleMesh triangleMesh;
-    std::ifstream meshFile(argv[1]);
 
-    if (!meshFile.good() || !triangleMesh.readFromObjFile(meshFile)) {
+    if (!triangleMesh.readFromObjFile(std::string(argv[1]))) {
         std::cerr << "Read failed for object: " << argv[1] << std::endl;
         return EXIT_FAILURE;
     }
@@ -31,17 +203,21 @@ int main(int argc, char** argv) {
 
     std::filesystem::path objFilePath = outputPath / argv[1];
 
-    std::cout << "Unwrapping..." << std::endl;
+    std::cout << "Unwrapping in the background..." << std::endl;
 
-    triangleMesh.unwrap();
+    unwrapParameters.progress = [](const UnwrapProgress& progress) {
+        std::cout << "  " << progress.iterations << " iterations, residual " << progress.residual
+                  << ", " << progress.elapsedSeconds << "s" << std::endl;
+    };
 
-    std::cout << "Finished unwrapping" << std::endl;
+    // The window opens on the mesh right away, its UVs fill in as the solve converges
+    UnwrapWorker unwrapWorker(triangleMesh, unwrapParameters);
 
     std::string unwrappedObjPath = outputPath / (objFilePath.stem().string() + "_unwrapped.obj");
     std::string pngFilePath = outputPath / objFilePath.stem().replace_extension(".png");
 
     RenderParameters renderParameters(unwrappedObjPath, pngFilePath);
-    RenderWindow renderWindow(&triangleMesh, &renderParameters, argv[1]);
+    RenderWindow renderWindow(&triangleMesh, &renderParameters, &unwrapWorker, argv[1]);
     RenderController renderController(&renderParameters, &renderWindow);
 
     renderWindow.resize(826, 700);
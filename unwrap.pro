@@ -5,7 +5,7 @@ TARGET = ./bin/unwrap
 INCLUDEPATH += ./src
 OBJECTS_DIR=./build/obj
 MOC_DIR=./build/moc
-CONFIG += c++17
+CONFIG += c++17 thread
 
  # You can make your code fail to compile if you use deprecated APIs.
  # In order to do so, uncomment the following line.
@@ -15,28 +15,68 @@ CONFIG += c++17
  #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
  # Input
- HEADERS += src/ArcBall.h \
+ HEADERS += src/AlgebraicMultigrid.h \
+            src/ArcBall.h \
+            src/AtlasPacker.h \
             src/ArcBallWidget.h \
+            src/BiCgStabSolver.h \
+            src/BucketQueue.h \
             src/Cartesian3.h \
+            src/ConjugateGradientSolver.h \
             src/TriangleMesh.h \
             src/Homogeneous4.h \
+            src/LinearSolver.h \
+            src/MappedFile.h \
             src/Matrix4.h \
+            src/NeighbourTable.h \
+            src/ObjParser.h \
+            src/Ordering.h \
+            src/Preconditioner.h \
+            src/Parallel.h \
             src/Quaternion.h \
+            src/RelaxationKernels.h \
             src/RenderController.h \
             src/RenderParameters.h \
             src/RenderWidget.h \
             src/RenderWindow.h \
+            src/SparseLUSolver.h \
+            src/SparseMatrix.h \
+            src/SweepAccelerator.h \
+            src/UnionFind.h \
+            src/UnwrapMonitor.h \
+            src/UnwrapParameters.h \
+            src/UnwrapWorker.h \
+            src/UvSnapshotBuffer.h \
 
- SOURCES += src/ArcBall.cpp \
+ SOURCES += src/AlgebraicMultigrid.cpp \
+            src/ArcBall.cpp \
+            src/AtlasPacker.cpp \
             src/ArcBallWidget.cpp \
+            src/BiCgStabSolver.cpp \
+            src/BucketQueue.cpp \
             src/Cartesian3.cpp \
+            src/ConjugateGradientSolver.cpp \
             src/TriangleMesh.cpp \
             src/Homogeneous4.cpp \
+            src/LinearSolver.cpp \
             src/main.cpp \
+            src/MappedFile.cpp \
             src/Matrix4.cpp \
+            src/NeighbourTable.cpp \
+            src/ObjParser.cpp \
+            src/Ordering.cpp \
+            src/Preconditioner.cpp \
             src/Quaternion.cpp \
+            src/RelaxationKernels.cpp \
             src/RenderController.cpp \
             src/RenderWidget.cpp \
-            src/RenderWindow.cpp
+            src/RenderWindow.cpp \
+            src/SparseLUSolver.cpp \
+            src/SparseMatrix.cpp \
+            src/SweepAccelerator.cpp \
+            src/UnionFind.cpp \
+            src/UnwrapMonitor.cpp \
+            src/UnwrapWorker.cpp \
+            src/UvSnapshotBuffer.cpp
 
 